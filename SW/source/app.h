@@ -6,6 +6,9 @@
 //  1.00     | 01/Jun/2025 |                               | ALCP             //
 // - First Version from HMSG 01.12                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - APP_EVENT_DRIVEN                                                         //
+//----------------------------------------------------------------------------//
 
 
 #ifndef APP_H
@@ -24,6 +27,11 @@ extern "C" {
 //----------------------------------------------------------------------------//
 #define APP_SW_MAIN_VERSION  "00"
 #define APP_SW_SUB_VERSION  "01"
+/* Event driven manager: threads sleep (epoll) on the socket, buffer eventfds
+ * and a timerfd for the periodic tick. Comment to use the polling (usleep) 
+ * loops.
+ */
+#define APP_EVENT_DRIVEN
     
 //----------------------------------------------------------------------------//
 // EXTERNAL TYPES
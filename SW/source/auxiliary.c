@@ -9,6 +9,9 @@
 //  1.01     | 30/Jul/2025 |                               | ALCP             //
 // - Updates to remove unused parts from HMSG 01.12                           //
 //----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - aux_getnsSinceEpoch                                                      //
+//----------------------------------------------------------------------------//
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -49,6 +52,17 @@ unsigned long long aux_getmsSinceEpoch(void)
     
     return millisecondsSinceEpoch;
 }
+/* Get Timestamp in nanoseconds since epoch. */
+unsigned long long aux_getnsSinceEpoch(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_REALTIME, &ts);
+    
+    return (unsigned long long)(ts.tv_sec) * 1000000000ULL + 
+            (unsigned long long)(ts.tv_nsec);
+}
+
 /** Try to convert string to number, and returns if it was ok */
 bool aux_parseLong(const char *str, long *val, int base)
 {
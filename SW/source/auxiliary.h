@@ -6,6 +6,9 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First Version: copied from HMSG 01.12                                    //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - aux_getnsSinceEpoch                                                      //
+//----------------------------------------------------------------------------//
 
 #ifndef AUXILIARY_H
 #define AUXILIARY_H
@@ -41,6 +44,15 @@ extern "C" {
  */
 unsigned long long aux_getmsSinceEpoch(void);
 
+/**
+ * Get Timestamp in nanoseconds since epoch (same clock as the kernel receive 
+ * timestamps of the CAN frames).
+ * 
+ * \param   None
+ * \return  nanoseconds since epoch.
+ */
+unsigned long long aux_getnsSinceEpoch(void);
+
 /**
  * Try to convert string to number, and returns if it was ok.
  * 
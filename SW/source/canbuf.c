@@ -6,14 +6,51 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First Version: copied from HMSG 01.12                                    //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - Buffers created with fixed element sizes (no malloc on push/pop)         //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Single record buffers (frame + timestamp) instead of DATA/STAMP pairs    //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - Read / Write buffers are lock-free SPSC buffers (spscbuf)                //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - Batched receive (recvmmsg) with tunable batch size and statistics        //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - Batched send (sendmmsg): unsent frames stay in the Write Buffer          //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - Read records are stamped with the kernel receive time in nanoseconds     //
+//----------------------------------------------------------------------------//
+//  1.07     | 16/Oct/2026 |                               | ALCP             //
+// - canbuf_enableEvents: eventfd signalled on buffer push                    //
+//----------------------------------------------------------------------------//
+//  1.08     | 16/Oct/2026 |                               | ALCP             //
+// - canbuf_setWriteMsgsToBuffer: several frames with a single lock           //
+//----------------------------------------------------------------------------//
+//  1.09     | 16/Oct/2026 |                               | ALCP             //
+// - canbuf_getWriteCount: frames waiting in the Write Buffer                 //
+//----------------------------------------------------------------------------//
+//  1.10     | 16/Oct/2026 |                               | ALCP             //
+// - Write lanes (interactive, control, background): strict priority          //
+//----------------------------------------------------------------------------//
+//  1.11     | 16/Oct/2026 |                               | ALCP             //
+// - Lane high-water mark updated by the producers after the push             //
+//----------------------------------------------------------------------------//
+//  1.12     | 16/Oct/2026 |                               | ALCP             //
+// - Control lane removed (loads OFF kept in order with the actions)          //
+//----------------------------------------------------------------------------//
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include "debug.h"
-#include "buffer.h"
+#include "spscbuf.h"
 #include "auxiliary.h"
 #include "socketcan.h"
 #include "canbuf.h"
@@ -21,9 +58,8 @@
 //----------------------------------------------------------------------------//
 // INTERNAL DEFINITIONS
 //----------------------------------------------------------------------------//
-/* Buffer Offset */
-#define NUMBER_OF_CAN_WRITE_BUFFERS (CAN_WRITE_STAMP_BUFFER - CAN_WRITE_DATA_BUFFER + 1)
-#define NUMBER_OF_CAN_READ_BUFFERS  (CAN_READ_STAMP_BUFFER - CAN_READ_DATA_BUFFER + 1)
+// Receive statistics debug print period (read syscalls)
+#define CAN_RECEIVE_STATS_PERIOD    1000
 
 //----------------------------------------------------------------------------//
 // INTERNAL GLOBAL VARIABLES
@@ -31,25 +67,47 @@
 // State: For two CAN Channels: use {CAN_DISCONNECTED, CAN_DISCONNECTED};
 volatile stateCAN_t canbufState[SOCKETCAN_CHANNELS] = {CAN_DISCONNECTED};
 // ID: For two CAN channels
-   //{-1, -1, -1, -1} ,   /*  initializers for row indexed by 0 */
-   //{-1, -1, -1, -1}     /*  initializers for row indexed by 1 */
+   //{-1, -1} ,   /*  initializers for row indexed by 0 */
+   //{-1, -1}     /*  initializers for row indexed by 1 */
+// (one per buffer: read and write lanes)
 static int canbufID[SOCKETCAN_CHANNELS][CAN_NUMBER_OF_BUFFERS] = {
-   {-1, -1, -1, -1}   /*  initializers for row indexed by 0 */
+   {-1, -1, -1}   /*  initializers for row indexed by 0 */
 };
 // File descriptor: // For two CAN Channels: {-1, -1};
 static int fd[SOCKETCAN_CHANNELS] = {-1}; 
 
 static pthread_mutex_t cb_state_mutex[SOCKETCAN_CHANNELS] = {
     PTHREAD_MUTEX_INITIALIZER};
-static pthread_mutex_t cb_read_mutex[SOCKETCAN_CHANNELS] = {
-    PTHREAD_MUTEX_INITIALIZER};
-static pthread_mutex_t cb_write_mutex[SOCKETCAN_CHANNELS] = {
+/* The write buffers (lanes) have only one consumer (write thread) but more 
+ * producers (actions, loads, ...): producers are serialized here, per lane. 
+ * The read buffer has one producer (read thread) and one consumer (buffers 
+ * thread): no lock.
+ */
+static pthread_mutex_t cb_write_mutex[SOCKETCAN_CHANNELS][CAN_NUMBER_OF_LANES] =
+{
+    {PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER}
+};
+// Write lanes statistics (written by the write thread)
+static pthread_mutex_t cb_stats_mutex[SOCKETCAN_CHANNELS] = {
     PTHREAD_MUTEX_INITIALIZER};
+static canbufLaneStats_t cb_laneStats[SOCKETCAN_CHANNELS][CAN_NUMBER_OF_LANES];
+// Write lanes high-water mark (written by the producers, cb_write_mutex)
+static unsigned int cb_laneHighWaterMark[SOCKETCAN_CHANNELS]
+        [CAN_NUMBER_OF_LANES];
+
+// Receive batch size and statistics (written by the read thread only)
+static atomic_int cb_receiveBatch = CAN_RECEIVE_BATCH_SIZE;
+static atomic_ullong cb_receiveFrames[SOCKETCAN_CHANNELS];
+static atomic_ullong cb_receiveSyscalls[SOCKETCAN_CHANNELS];
 
 //----------------------------------------------------------------------------//
 // INTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
 static int canbuf_validateChannel(int channel);
+static int canbuf_validateLane(canLane_t lane);
+static void canbuf_updateHighWaterMark(int channel, canLane_t lane);
+static void canbuf_updateLaneStats(int channel, canLane_t lane, 
+        canbufRecord_t* records, int sent);
 static stateCAN_t getCANBufState(int channel);
 static void setCANBufState(int channel, stateCAN_t cState);
 
@@ -71,6 +129,71 @@ static int canbuf_validateChannel(int channel)
     }
 }
 
+/**
+ * CAN Validate write lane
+ * \param   lane        Write lane
+ * \return  EXIT_SUCCESS / EXIT_FAILURE
+ */
+static int canbuf_validateLane(canLane_t lane)
+{
+    if( (lane < CAN_LANE_INTERACTIVE) || (lane >= CAN_NUMBER_OF_LANES) )
+    {
+        return EXIT_FAILURE;
+    }
+    else
+    {
+        return EXIT_SUCCESS;
+    }
+}
+
+/**
+ * Update the high-water mark of a write lane after a push (producer, called 
+ * with cb_write_mutex[channel][lane] locked)
+ */
+static void canbuf_updateHighWaterMark(int channel, canLane_t lane)
+{
+    unsigned int count;
+    count = spscbuf_dataCount(canbufID[channel][CAN_WRITE_BUFFER + lane]);
+    if(count > cb_laneHighWaterMark[channel][lane])
+    {
+        cb_laneHighWaterMark[channel][lane] = count;
+    }
+}
+
+/**
+ * Update the latency statistics of a write lane on send (write thread)
+ * \param   records     Records peeked from the lane (sent first)
+ * \param   sent        Number of records sent
+ */
+static void canbuf_updateLaneStats(int channel, canLane_t lane, 
+        canbufRecord_t* records, int sent)
+{
+    canbufLaneStats_t* stats;
+    unsigned long long now;
+    unsigned long long latency;
+    int li_index;
+    now = aux_getmsSinceEpoch();
+    // LOCK STATS
+    pthread_mutex_lock(&cb_stats_mutex[channel]);
+    stats = &cb_laneStats[channel][lane];
+    for(li_index = 0; li_index < sent; li_index++)
+    {
+        latency = 0;
+        if(now > records[li_index].timestamp)
+        {
+            latency = now - records[li_index].timestamp;
+        }
+        stats->totalLatency += latency;
+        if(latency > stats->maxLatency)
+        {
+            stats->maxLatency = latency;
+        }
+    }
+    stats->frames += (unsigned long long)sent;
+    // UNLOCK STATS
+    pthread_mutex_unlock(&cb_stats_mutex[channel]);
+}
+
 static stateCAN_t getCANBufState(int channel)
 {
     stateCAN_t lcs_State;
@@ -124,7 +247,8 @@ int canbuf_init(int channel)
     {
         if(canbufID[channel][count] < 0)
         {
-            canbufID[channel][count] = buffer_init(CAN_BUFFER_SIZE);
+            canbufID[channel][count] = spscbuf_init(CAN_BUFFER_SIZE, 
+                    sizeof(canbufRecord_t));
         }
     }
     // Check buffers - All should have ID
@@ -153,6 +277,23 @@ int canbuf_init(int channel)
     }
 }
 
+/* CAN Buffer push notifications */
+int canbuf_enableEvents(int channel, int buffer)
+{
+    // Validate channel and buffer
+    if( (canbuf_validateChannel(channel) == EXIT_FAILURE) || 
+            (buffer < CAN_READ_BUFFER) || (buffer >= CAN_NUMBER_OF_BUFFERS) )
+    {
+        #ifdef DEBUG_CANBUF_ERRORS
+        debug_print("CAN: canbuf_enableEvents ERROR - Parameter Error!\n");
+        debug_print("- Channel: %d\n", channel);
+        debug_print("- Buffer: %d\n", buffer);
+        #endif
+        return -1;
+    }
+    return spscbuf_enableEvents(canbufID[channel][buffer]);
+}
+
 /* CAN Initialization - Socket Connection */
 int canbuf_connect(int channel)
 {
@@ -195,18 +336,11 @@ int canbuf_connect(int channel)
             //-----------------------------------------------------------------
             // JUST CONNECTED - CLEAR BUFFERS
             //-----------------------------------------------------------------
-            // LOCK BUFFERS: Protect data and timestamp buffers from being 
-            // read/written at different times
-            pthread_mutex_lock(&cb_read_mutex[channel]);
-            pthread_mutex_lock(&cb_write_mutex[channel]);            
-            for(li_index = CAN_READ_DATA_BUFFER; 
+            for(li_index = CAN_READ_BUFFER; 
                     li_index < CAN_NUMBER_OF_BUFFERS; li_index++)
             {
-                buffer_clean(canbufID[channel][li_index]);
+                spscbuf_clean(canbufID[channel][li_index]);
             }
-            // UNLOCK BUFFERS:
-            pthread_mutex_unlock(&cb_read_mutex[channel]);
-            pthread_mutex_unlock(&cb_write_mutex[channel]);
         }
         /* Set State */
         setCANBufState(channel, CAN_CONNECTED);
@@ -244,18 +378,11 @@ int canbuf_close(int channel, int cleanBuffers)
     // Check if clean buffers
     if(cleanBuffers > 0)
     {
-        // LOCK BUFFERS: Protect data and timestamp buffers from being 
-        // read/written at different times
-        pthread_mutex_lock(&cb_read_mutex[channel]);
-        pthread_mutex_lock(&cb_write_mutex[channel]);
-        for(li_index = CAN_READ_DATA_BUFFER; 
+        for(li_index = CAN_READ_BUFFER; 
                 li_index < CAN_NUMBER_OF_BUFFERS; li_index++)
         {
-            buffer_clean(canbufID[channel][li_index]);
+            spscbuf_clean(canbufID[channel][li_index]);
         }
-        // UNLOCK BUFFERS:
-        pthread_mutex_unlock(&cb_read_mutex[channel]);
-        pthread_mutex_unlock(&cb_write_mutex[channel]);
     }
     
     // Return
@@ -286,14 +413,15 @@ int canbuf_getState(int channel, stateCAN_t* scp_state)
 }
 
 /** Set Write buffer with data from parameters */
-int canbuf_setWriteMsgToBuffer(int channel, struct can_frame* pcf_Frame, 
-        unsigned long long millisecondsSinceEpoch)
+int canbuf_setWriteMsgToBuffer(int channel, canLane_t lane, 
+        struct can_frame* pcf_Frame, unsigned long long millisecondsSinceEpoch)
 {    
-    int li_index;
-    int check[NUMBER_OF_CAN_WRITE_BUFFERS];
+    int check;
+    canbufRecord_t record;
     
-    // Validate channel
-    if( canbuf_validateChannel(channel) == EXIT_FAILURE )
+    // Validate channel and lane
+    if( (canbuf_validateChannel(channel) == EXIT_FAILURE) || 
+            (canbuf_validateLane(lane) == EXIT_FAILURE) )
     {
         /***************/
         /* FATAL ERROR */
@@ -301,204 +429,194 @@ int canbuf_setWriteMsgToBuffer(int channel, struct can_frame* pcf_Frame,
         #ifdef DEBUG_CANBUF_ERRORS
         debug_print("CAN: canbuf_setWriteMsgToBuffer ERROR - Channel Error!\n");
         debug_print("- Channel: %d\n", channel);
+        debug_print("- Lane: %d\n", lane);
         #endif
         return CAN_SEND_PARAMETER_ERROR;
     }
     
-    // Simply add data to Publish buffers
-    li_index = 0;
-    // LOCK BUFFERS: Protect data and timestamp buffers from being 
-    // read/written at different times
-    pthread_mutex_lock(&cb_write_mutex[channel]);
-    check[li_index] = buffer_push(canbufID[channel][CAN_WRITE_DATA_BUFFER], 
-            pcf_Frame, sizeof(*pcf_Frame));
-    li_index++;
-    check[li_index] = buffer_push(canbufID[channel][CAN_WRITE_STAMP_BUFFER], 
-            &millisecondsSinceEpoch, sizeof(millisecondsSinceEpoch));
-    // UNLOCK BUFFERS:
-    pthread_mutex_unlock(&cb_write_mutex[channel]);
+    // Frame and timestamp are added as a single record
+    record.frame = *pcf_Frame;
+    record.timestamp = millisecondsSinceEpoch;
+    // LOCK WRITE: Serialize producers (single producer buffer)
+    pthread_mutex_lock(&cb_write_mutex[channel][lane]);
+    check = spscbuf_push(canbufID[channel][CAN_WRITE_BUFFER + lane], &record);
+    if( check == SPSCBUF_OK )
+    {
+        canbuf_updateHighWaterMark(channel, lane);
+    }
+    // UNLOCK WRITE:
+    pthread_mutex_unlock(&cb_write_mutex[channel][lane]);
     /* Check for critical errors */
-    for(li_index = 0; li_index < NUMBER_OF_CAN_WRITE_BUFFERS; li_index++)
+    if( check != SPSCBUF_OK )
     {
-        if( check[li_index] != BUFFER_OK )
-        {
-            /***************/
-            /* FATAL ERROR */
-            /***************/
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("CAN: canbuf_setWriteMsgToBuffer - Buffer Error!\n");
-            debug_print("- Channel: %d\n", channel);
-            debug_print("- CAN Write Buffer Index: %d\n", li_index);
-            debug_print("- CAN Write Buffer Error: %d\n", check[li_index]);
-            #endif
-            return CAN_SEND_BUFFER_ERROR;
-        }
+        /***************/
+        /* FATAL ERROR */
+        /***************/
+        #ifdef DEBUG_CANBUF_ERRORS
+        debug_print("CAN: canbuf_setWriteMsgToBuffer - Buffer Error!\n");
+        debug_print("- Channel: %d\n", channel);
+        debug_print("- CAN Write Buffer Error: %d\n", check);
+        #endif
+        return CAN_SEND_BUFFER_ERROR;
     }
     
     // Here all is good
     return CAN_SEND_OK;
 }
 
-/* CAN Send Data from Write Buffer */
-int canbuf_send(int channel)
+int canbuf_setWriteMsgsToBuffer(int channel, canLane_t lane, 
+        struct can_frame* pcf_Frames, int count, 
+        unsigned long long millisecondsSinceEpoch)
 {
-    unsigned long long millisecondsSinceEpoch;
-    struct can_frame cf_Frame;
-    int li_position;
+    canbufRecord_t records[CAN_SEND_BATCH_SIZE];
     int li_index;
-    int li_temp;
-    unsigned int lui_size;
-    unsigned int bufferSize[NUMBER_OF_CAN_WRITE_BUFFERS];
-    int li_return;
+    int li_batch;
+    int li_pushed;
     
-    // Validate channel
-    if( canbuf_validateChannel(channel) == EXIT_FAILURE )
+    // Validate channel and lane
+    if( (canbuf_validateChannel(channel) == EXIT_FAILURE) || 
+            (canbuf_validateLane(lane) == EXIT_FAILURE) )
     {
         /***************/
         /* FATAL ERROR */
         /***************/
         #ifdef DEBUG_CANBUF_ERRORS
-        debug_print("CAN: canbuf_send ERROR - Channel Error!\n");
+        debug_print("CAN: canbuf_setWriteMsgsToBuffer ERROR - Channel "
+                "Error!\n");
         debug_print("- Channel: %d\n", channel);
+        debug_print("- Lane: %d\n", lane);
         #endif
         return CAN_SEND_PARAMETER_ERROR;
     }
     
-    /**************************************************************************
-    * CONSISTENCY CHECK
-    *************************************************************************/
-    // LOCK BUFFERS: Protect data and timestamp buffers from being read/written 
-    // at different times
-    pthread_mutex_lock(&cb_write_mutex[channel]);
-    // Get every write buffer count
-    for(li_index = 0; li_index < NUMBER_OF_CAN_WRITE_BUFFERS; li_index++)
-    {        
-        // Get the number of elements in the buffer
-        li_position = CAN_WRITE_DATA_BUFFER + li_index;
-        bufferSize[li_index] = buffer_dataCount(canbufID[channel][li_position]);
-    }        
-    // Check if every write buffer is not empty
-    li_temp = 0;
-    for(li_index = 0; li_index < NUMBER_OF_CAN_WRITE_BUFFERS; li_index++)
-    {        
-        if( bufferSize[li_index] != 0 )
+    // LOCK WRITE: Serialize producers (single producer buffer)
+    pthread_mutex_lock(&cb_write_mutex[channel][lane]);
+    li_pushed = 0;
+    while(li_pushed < count)
+    {
+        // Frames and timestamp are added as records (one push per batch)
+        li_batch = count - li_pushed;
+        if(li_batch > CAN_SEND_BATCH_SIZE)
         {
-            li_temp = 1;
+            li_batch = CAN_SEND_BATCH_SIZE;
         }
-    }
-    if(li_temp == 0)
-    {
-        // No data to be sent - Unlock buffers and return now
-        // UNLOCK BUFFERS
-        pthread_mutex_unlock(&cb_write_mutex[channel]);
-        return CAN_SEND_NO_DATA;
-    }    
-    // Check if every write buffer has the same count of elements
-    for(li_index = 0; li_index < NUMBER_OF_CAN_WRITE_BUFFERS - 1; li_index++)
-    {        
-        if( bufferSize[li_index] != bufferSize[li_index + 1] )
-        {            
-            /************************/
-            /* BUFFERNS OUT OF SYNC */
-            /************************/
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("canbuf_send: Write Buffer ERROR!\n (pre-check)");
-            debug_print("- Channel: %d\n", channel);
-            #endif
-            // Buffers out of sync - Unlock buffers and return now
-            // UNLOCK BUFFERS
-            pthread_mutex_unlock(&cb_write_mutex[channel]);
-            return CAN_SEND_BUFFER_ERROR;
+        for(li_index = 0; li_index < li_batch; li_index++)
+        {
+            records[li_index].frame = pcf_Frames[li_pushed + li_index];
+            records[li_index].timestamp = millisecondsSinceEpoch;
         }
-    }            
-    /* SEND DATA: At this point, the buffers are in sync, and there is data to 
-     * be sent
-     */        
-    /*******************************************************************
-    * FILL DATA - can frame, millisecondsSinceEpoch
-    *******************************************************************/
-    li_return = CAN_SEND_OK;
-    li_position = CAN_WRITE_DATA_BUFFER;
-    lui_size = buffer_popSize(canbufID[channel][li_position]);
-    if(lui_size > 0)
-    {
-        li_temp = buffer_pop(canbufID[channel][li_position], &cf_Frame, 
-                sizeof(cf_Frame));
-        if( (li_temp != BUFFER_OK) || (lui_size != sizeof(cf_Frame)) )
+        li_index = spscbuf_pushN(canbufID[channel][CAN_WRITE_BUFFER + lane], 
+                records, li_batch);
+        if(li_index > 0)
         {
-            /***************/
-            /* FATAL ERROR */
-            /***************/
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("canbuf_send: Write Buffer ERROR! (data pop)\n");
-            debug_print("- Channel: %d\n", channel);
-            debug_print("- Buffer ID: %d\n", li_position);
-            debug_print("- Data Size: %d\n", lui_size);
-            #endif
-            li_return = CAN_SEND_BUFFER_ERROR;
+            canbuf_updateHighWaterMark(channel, lane);
         }
+        if(li_index != li_batch)
+        {
+            break;
+        }
+        li_pushed += li_batch;
     }
-    else
+    // UNLOCK WRITE:
+    pthread_mutex_unlock(&cb_write_mutex[channel][lane]);
+    /* Check for critical errors */
+    if( li_pushed < count )
     {
         /***************/
         /* FATAL ERROR */
         /***************/
         #ifdef DEBUG_CANBUF_ERRORS
-        debug_print("canbuf_send: Write Buffer ERROR - Data Size is 0!\n");
+        debug_print("CAN: canbuf_setWriteMsgsToBuffer - Buffer Error!\n");
         debug_print("- Channel: %d\n", channel);
-        debug_print("- Buffer ID: %d\n", li_position);
-        debug_print("- Data Size: %d\n", lui_size);
+        debug_print("- Frames not set: %d\n", count - li_pushed);
         #endif
-        li_return = CAN_SEND_BUFFER_ERROR;
+        return CAN_SEND_BUFFER_ERROR;
     }
-    // Pop timestamp to keep buffers sync
-    li_position = CAN_WRITE_STAMP_BUFFER;
-    lui_size = buffer_popSize(canbufID[channel][li_position]);
-    if(lui_size > 0)
+    
+    // Here all is good
+    return CAN_SEND_OK;
+}
+
+/* CAN Send Data from Write Buffer */
+int canbuf_send(int channel)
+{
+    canbufRecord_t records[CAN_SEND_BATCH_SIZE];
+    struct can_frame frames[CAN_SEND_BATCH_SIZE];
+    canLane_t lane;
+    int li_position;
+    int li_count;
+    int li_index;
+    int li_temp;
+    
+    // Validate channel
+    if( canbuf_validateChannel(channel) == EXIT_FAILURE )
     {
-        li_temp = buffer_pop(canbufID[channel][li_position], 
-                &millisecondsSinceEpoch, sizeof(millisecondsSinceEpoch));
-        if( (li_temp != BUFFER_OK) || 
-                (lui_size != sizeof(millisecondsSinceEpoch)) )
+        /***************/
+        /* FATAL ERROR */
+        /***************/
+        #ifdef DEBUG_CANBUF_ERRORS
+        debug_print("CAN: canbuf_send ERROR - Channel Error!\n");
+        debug_print("- Channel: %d\n", channel);
+        #endif
+        return CAN_SEND_PARAMETER_ERROR;
+    }
+    
+    /*******************************************************************
+    * FILL DATA - records (can frame and timestamp) - kept in buffer
+    * First lane with data (strict priority)
+    *******************************************************************/
+    li_position = CAN_WRITE_BUFFER;
+    li_count = 0;
+    for(lane = CAN_LANE_INTERACTIVE; lane < CAN_NUMBER_OF_LANES; lane++)
+    {
+        li_position = CAN_WRITE_BUFFER + lane;
+        li_count = spscbuf_peekN(canbufID[channel][li_position], records, 
+                CAN_SEND_BATCH_SIZE);
+        if(li_count != 0)
         {
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("canbuf_send: Write Buffer ERROR! (timestamp pop)\n");
-            debug_print("- Channel: %d\n", channel);
-            debug_print("- Buffer ID: %d\n", li_position);
-            debug_print("- Data Size: %d\n", lui_size);
-            #endif
-            li_return = CAN_SEND_BUFFER_ERROR;
+            break;
         }
     }
-    else
+    if(li_count == 0)
+    {
+        // No data to be sent
+        return CAN_SEND_NO_DATA;
+    }
+    if(li_count < 0)
     {
         /***************/
         /* FATAL ERROR */
         /***************/
         #ifdef DEBUG_CANBUF_ERRORS
-        debug_print("canbuf_send: Write Buffer ERROR - Data Size is 0!\n");
+        debug_print("canbuf_send: Write Buffer ERROR! (data peek)\n");
         debug_print("- Channel: %d\n", channel);
         debug_print("- Buffer ID: %d\n", li_position);
-        debug_print("- Data Size: %d\n", lui_size);
+        debug_print("- Error: %d\n", li_count);
         #endif
-        li_return = CAN_SEND_BUFFER_ERROR;
+        return CAN_SEND_BUFFER_ERROR;
     }
-    // UNLOCK BUFFERS:
-    pthread_mutex_unlock(&cb_write_mutex[channel]);
-    // Check errors
-    if(li_return != CAN_SEND_OK)
+    for(li_index = 0; li_index < li_count; li_index++)
     {
-        return li_return;
+        frames[li_index] = records[li_index].frame;
+        #ifdef DEBUG_CANBUF_SEND
+        debug_printCAN("canbuf_send: There is data to be sent:\n", 
+                &frames[li_index]);
+        #endif
     }
     /*******************************************************************
     * SEND DATA
     *******************************************************************/
-    // Send Data - At this point all buffers and data sizes are validated
-    #ifdef DEBUG_CANBUF_SEND
-    debug_printCAN("canbuf_send: There is data to be sent:\n", &cf_Frame);
-    #endif
-    li_temp = socketcan_write(fd[channel], &cf_Frame);
-    if(li_temp < 0)
+    // Send Data - At this point the records are validated
+    li_temp = socketcan_writeBatch(fd[channel], frames, li_count);
+    if(li_temp == SOCKETCAN_BUSY)
+    {
+        // Transmit queue full - keep all frames in buffer and retry later
+        #ifdef DEBUG_CANBUF_SEND
+        debug_print("canbuf_send: Socket Busy!\n");
+        #endif
+        return CAN_SEND_BUSY;
+    }
+    else if(li_temp < 0)
     {
         #ifdef DEBUG_CANBUF_ERRORS
         debug_print("canbuf_send: Socket Write ERROR!\n");
@@ -509,8 +627,12 @@ int canbuf_send(int channel)
     }
     else
     {
+        // Remove only the frames sent - the others are sent next time
+        canbuf_updateLaneStats(channel, lane, records, li_temp);
+        spscbuf_discard(canbufID[channel][li_position], (unsigned int)li_temp);
         #ifdef DEBUG_CANBUF_SEND
-        debug_print("canbuf_send: Data sent!\n");
+        debug_print("canbuf_send: Data sent: %d/%d frames!\n", li_temp, 
+                li_count);
         #endif
         return CAN_SEND_OK;
     }
@@ -518,14 +640,11 @@ int canbuf_send(int channel)
 
 /** Get data from Read buffer and set data from parameters */
 int canbuf_getReadMsgFromBuffer(int channel, struct can_frame* pcf_Frame, 
-        unsigned long long* millisecondsSinceEpoch)
+        unsigned long long* nanosecondsSinceEpoch)
 {
-    int li_index;
-    unsigned int bufferSize[NUMBER_OF_CAN_WRITE_BUFFERS];
+    canbufRecord_t record;
     int li_position;
     int li_temp;
-    unsigned int lui_size;
-    int li_return = CAN_RECEIVE_OK;
     
     // Validate channel
     if( canbuf_validateChannel(channel) == EXIT_FAILURE )
@@ -539,140 +658,45 @@ int canbuf_getReadMsgFromBuffer(int channel, struct can_frame* pcf_Frame,
         #endif
         return CAN_RECEIVE_PARAMETER_ERROR;
     }    
-    // LOCK BUFFERS: Protect data and timestamp buffers from being read/written 
-    // at different times
-    pthread_mutex_lock(&cb_read_mutex[channel]);
-    /**************************************************************************
-    * CONSISTENCY CHECK
-    *************************************************************************/     
-    // Get every write buffer count
-    for(li_index = 0; li_index < NUMBER_OF_CAN_READ_BUFFERS; li_index++)
-    {        
-        // Get the number of elements in the buffer
-        li_position = CAN_READ_DATA_BUFFER + li_index;
-        bufferSize[li_index] = buffer_dataCount(canbufID[channel][li_position]);
-    }        
-    // Check if every buffer is not empty
-    li_temp = 0;
-    for(li_index = 0; li_index < NUMBER_OF_CAN_READ_BUFFERS; li_index++)
-    {        
-        if( bufferSize[li_index] != 0 )
-        {
-            li_temp = 1;
-        }
-    }
-    if(li_temp == 0)
-    {
-        // No data to be sent for this channel - Unlock and return now
-        // UNLOCK BUFFERS
-        pthread_mutex_unlock(&cb_read_mutex[channel]);
-        return CAN_RECEIVE_NO_DATA;
-    }    
-    // Check if every write buffer has the same count of elements
-    for(li_index = 0; li_index < NUMBER_OF_CAN_READ_BUFFERS - 1; li_index++)
-    {        
-        if( bufferSize[li_index] != bufferSize[li_index + 1] )
-        {            
-            /**********************/
-            /* BUFFER OUT OF SYNC */
-            /**********************/
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("CAN: Read Buffer ERROR!");
-            debug_print("- Channel: %d\n", channel);
-            #endif
-            // Buffers out of sync: Unlock buffer and return now
-            // UNLOCK BUFFER
-            pthread_mutex_unlock(&cb_read_mutex[channel]);
-            return CAN_RECEIVE_BUFFER_ERROR;
-        }
-    }
-    /* READ DATA: At this point, the buffers are in sync, and there is data to 
-     * be read
-     */        
-    li_return = CAN_RECEIVE_OK;    
     /*******************************************************************
-    * FILL DATA - can frame, millisecondsSinceEpoch
+    * FILL DATA - record (can frame and timestamp)
     *******************************************************************/
-    li_position = CAN_READ_DATA_BUFFER;
-    lui_size = buffer_popSize(canbufID[channel][li_position]);
-    if(lui_size > 0)
+    li_position = CAN_READ_BUFFER;
+    li_temp = spscbuf_pop(canbufID[channel][li_position], &record);
+    if(li_temp == SPSCBUF_EMPTY)
     {
-        li_temp = buffer_pop(canbufID[channel][li_position], pcf_Frame, 
-                sizeof(*pcf_Frame));
-        if( (li_temp != BUFFER_OK) || (lui_size != sizeof(*pcf_Frame)) )
-        {
-            /***************/
-            /* FATAL ERROR */
-            /***************/
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("CAN: Read Buffer ERROR!\n");
-            debug_print("- Channel: %d\n", channel);
-            debug_print("- Buffer ID: %d\n", li_position);
-            debug_print("- Data Size: %d\n", lui_size);
-            #endif
-            li_return = CAN_RECEIVE_BUFFER_ERROR;
-        }
-    }
-    else
-    {
-        /***************/
-        /* FATAL ERROR */
-        /***************/
-        #ifdef DEBUG_CANBUF_ERRORS
-        debug_print("CAN: Read Buffer ERROR - Data Size is 0!\n");
-        debug_print("- Channel: %d\n", channel);
-        debug_print("- Buffer ID: %d\n", li_position);
-        debug_print("- Data Size: %d\n", lui_size);
-        #endif
-        li_return = CAN_RECEIVE_BUFFER_ERROR;
-    }
-    // Pop timestamp to keep buffers sync
-    li_position = CAN_READ_STAMP_BUFFER;
-    lui_size = buffer_popSize(canbufID[channel][li_position]);
-    if(lui_size > 0)
-    {
-        li_temp = buffer_pop(canbufID[channel][li_position], 
-                millisecondsSinceEpoch, sizeof(*millisecondsSinceEpoch));
-        if( (li_temp != BUFFER_OK) || 
-                (lui_size != sizeof(*millisecondsSinceEpoch)) )
-        {
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("CAN: Read Buffer ERROR!\n");
-            debug_print("- Channel: %d\n", channel);
-            debug_print("- Buffer ID: %d\n", li_position);
-            debug_print("- Data Size: %d\n", lui_size);
-            #endif
-            li_return = CAN_RECEIVE_BUFFER_ERROR;
-        }
+        // No data to be read for this channel
+        return CAN_RECEIVE_NO_DATA;
     }
-    else
+    if(li_temp != SPSCBUF_OK)
     {
         /***************/
         /* FATAL ERROR */
         /***************/
         #ifdef DEBUG_CANBUF_ERRORS
-        debug_print("CAN: Read Buffer ERROR - Data Size is 0!\n");
+        debug_print("CAN: Read Buffer ERROR!\n");
         debug_print("- Channel: %d\n", channel);
         debug_print("- Buffer ID: %d\n", li_position);
-        debug_print("- Data Size: %d\n", lui_size);
+        debug_print("- Error: %d\n", li_temp);
         #endif
-        li_return = CAN_RECEIVE_BUFFER_ERROR;
+        return CAN_RECEIVE_BUFFER_ERROR;
     }
-    // UNLOCK BUFFERS:
-    pthread_mutex_unlock(&cb_read_mutex[channel]);    
+    *pcf_Frame = record.frame;
+    *nanosecondsSinceEpoch = record.timestamp;
     // Return
-    return li_return;
+    return CAN_RECEIVE_OK;
 }
 
 /* CAN read Data and fill Read Buffer */
 int canbuf_receive(int channel, int timeout)
 {
-    unsigned long long millisecondsSinceEpoch;
     int socketReturn;
-    struct can_frame cf_Frame;
-    int check[NUMBER_OF_CAN_READ_BUFFERS];
+    int check;
     int li_index;
-    int li_position;
+    unsigned long long lull_timestamp;
+    struct can_frame frames[SOCKETCAN_MAX_BATCH];
+    uint64_t timestamps[SOCKETCAN_MAX_BATCH];
+    canbufRecord_t records[SOCKETCAN_MAX_BATCH];
     
     // Validate channel
     if( canbuf_validateChannel(channel) == EXIT_FAILURE )
@@ -686,86 +710,194 @@ int canbuf_receive(int channel, int timeout)
         return CAN_RECEIVE_PARAMETER_ERROR;
     }
         
-    // Check for new data
-    socketReturn = socketcan_read(fd[channel], &cf_Frame, timeout);
+    // Check for new data - all available frames up to the batch size
+    socketReturn = socketcan_readBatch(fd[channel], frames, timestamps, 
+            atomic_load_explicit(&cb_receiveBatch, memory_order_relaxed), 
+            timeout);
     
     // Evaluate socket return
-    switch(socketReturn) 
+    if(socketReturn <= 0)
     {
-        case SOCKETCAN_OK:
-            // Get Timestamp
-            millisecondsSinceEpoch = aux_getmsSinceEpoch();
-            break;
+        switch(socketReturn) 
+        {
+            case SOCKETCAN_TIMEOUT:
+                return CAN_RECEIVE_NO_DATA;
+                break;
 
-        case SOCKETCAN_TIMEOUT:
-            return CAN_RECEIVE_NO_DATA;
-            break;
-            
-        case SOCKETCAN_ERROR:
-            /***************/
-            /* FATAL ERROR */
-            /***************/
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("CAN: Socket Read ERROR - SOCKETCAN_ERROR!\n");
-            #endif
-            return CAN_RECEIVE_SOCKET_ERROR;
-            break;
-            
-        case SOCKETCAN_OTHER_ERROR:
-            /***************/
-            /* FATAL ERROR */
-            /***************/
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("CAN: Socket Read ERROR - SOCKETCAN_OTHER_ERROR!\n");
-            #endif
-            return CAN_RECEIVE_SOCKET_ERROR;
-            break;
+            case SOCKETCAN_ERROR:
+                /***************/
+                /* FATAL ERROR */
+                /***************/
+                #ifdef DEBUG_CANBUF_ERRORS
+                debug_print("CAN: Socket Read ERROR - SOCKETCAN_ERROR!\n");
+                #endif
+                return CAN_RECEIVE_SOCKET_ERROR;
+                break;
 
-        default:
-            /***************/
-            /* FATAL ERROR */
-            /***************/
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("CAN: Socket Read ERROR - NON-STANDARD ERROR!\n");
-            #endif
-            return CAN_RECEIVE_SOCKET_ERROR;
-            break;
+            case SOCKETCAN_OTHER_ERROR:
+                /***************/
+                /* FATAL ERROR */
+                /***************/
+                #ifdef DEBUG_CANBUF_ERRORS
+                debug_print("CAN: Socket Read ERROR - SOCKETCAN_OTHER_ERROR!\n");
+                #endif
+                return CAN_RECEIVE_SOCKET_ERROR;
+                break;
+
+            default:
+                /***************/
+                /* FATAL ERROR */
+                /***************/
+                #ifdef DEBUG_CANBUF_ERRORS
+                debug_print("CAN: Socket Read ERROR - NON-STANDARD ERROR!\n");
+                #endif
+                return CAN_RECEIVE_SOCKET_ERROR;
+                break;
+        }
+    }
+    
+    // Statistics
+    atomic_fetch_add_explicit(&cb_receiveFrames[channel], 
+            (unsigned long long)socketReturn, memory_order_relaxed);
+    atomic_fetch_add_explicit(&cb_receiveSyscalls[channel], 1, 
+            memory_order_relaxed);
+    #ifdef DEBUG_CANBUF_RECEIVE_STATS
+    if( (atomic_load_explicit(&cb_receiveSyscalls[channel], 
+            memory_order_relaxed) % CAN_RECEIVE_STATS_PERIOD) == 0 )
+    {
+        debug_print("CAN: Receive Stats - Channel %d: %llu frames / %llu "
+                "syscalls\n", channel, 
+                atomic_load_explicit(&cb_receiveFrames[channel], 
+                memory_order_relaxed), 
+                atomic_load_explicit(&cb_receiveSyscalls[channel], 
+                memory_order_relaxed));
     }
+    #endif
     
-    // Get the position depending on the channel
-    li_position = CAN_READ_DATA_BUFFER;
-    li_index = 0;
+    /* Timestamp (ns): kernel receive time. If not available (no kernel 
+     * support) the read time is used instead, same for all frames from the 
+     * same syscall.
+     */
+    lull_timestamp = 0;
+    for(li_index = 0; li_index < socketReturn; li_index++)
+    {
+        records[li_index].frame = frames[li_index];
+        if(timestamps[li_index] != 0)
+        {
+            records[li_index].timestamp = timestamps[li_index];
+        }
+        else
+        {
+            if(lull_timestamp == 0)
+            {
+                lull_timestamp = aux_getnsSinceEpoch();
+            }
+            records[li_index].timestamp = lull_timestamp;
+        }
+    }
     
     //--------------------------------------------------------------------------
-    // Add data to buffer and check results
+    // Add records to buffer (published at once) and check results
     //--------------------------------------------------------------------------
-    // LOCK BUFFERS: Protect data and timestamp buffers from being read/written 
-    // at different times
-    pthread_mutex_lock(&cb_read_mutex[channel]);
-    check[li_index] = buffer_push(canbufID[channel][li_position], &cf_Frame, 
-            sizeof(cf_Frame));
-    li_position++;
-    li_index++;
-    check[li_index] = buffer_push(canbufID[channel][li_position], 
-            &millisecondsSinceEpoch, sizeof(millisecondsSinceEpoch));
-    // UNLOCK BUFFERS:
-    pthread_mutex_unlock(&cb_read_mutex[channel]);
+    check = spscbuf_pushN(canbufID[channel][CAN_READ_BUFFER], records, 
+            (unsigned int)socketReturn);
     
     /* Check for critical errors */
-    for(li_index = 0; li_index < NUMBER_OF_CAN_READ_BUFFERS; li_index++)
+    if( check != socketReturn )
     {
-        if( check[li_index] != BUFFER_OK )
-        {
-            /***************/
-            /* FATAL ERROR */
-            /***************/
-            #ifdef DEBUG_CANBUF_ERRORS
-            debug_print("CAN: Socket Read ERROR - Buffer ERROR!\n");
-            #endif
-            return CAN_RECEIVE_BUFFER_ERROR;
-        }
+        /***************/
+        /* FATAL ERROR */
+        /***************/
+        #ifdef DEBUG_CANBUF_ERRORS
+        debug_print("CAN: Socket Read ERROR - Buffer ERROR!\n");
+        debug_print("- Frames read: %d\n", socketReturn);
+        debug_print("- Frames pushed: %d\n", check);
+        #endif
+        return CAN_RECEIVE_BUFFER_ERROR;
     }
     
     // Here - Return OK
     return CAN_RECEIVE_OK;
-}
\ No newline at end of file
+}
+
+/* Set the receive batch size */
+int canbuf_setReceiveBatch(int frames)
+{
+    if( (frames < 1) || (frames > SOCKETCAN_MAX_BATCH) )
+    {
+        #ifdef DEBUG_CANBUF_ERRORS
+        debug_print("CAN: canbuf_setReceiveBatch ERROR - Out of range!\n");
+        debug_print("- Frames: %d\n", frames);
+        #endif
+        return EXIT_FAILURE;
+    }
+    atomic_store_explicit(&cb_receiveBatch, frames, memory_order_relaxed);
+    return EXIT_SUCCESS;
+}
+
+/* Get the receive statistics */
+int canbuf_getReceiveStats(int channel, unsigned long long* frames, 
+        unsigned long long* syscalls)
+{
+    // Validate channel
+    if( canbuf_validateChannel(channel) == EXIT_FAILURE )
+    {
+        return EXIT_FAILURE;
+    }
+    *frames = atomic_load_explicit(&cb_receiveFrames[channel], 
+            memory_order_relaxed);
+    *syscalls = atomic_load_explicit(&cb_receiveSyscalls[channel], 
+            memory_order_relaxed);
+    return EXIT_SUCCESS;
+}
+
+/* Get the number of frames waiting in the Write Buffer (all lanes) */
+unsigned int canbuf_getWriteCount(int channel)
+{
+    unsigned int count;
+    canLane_t lane;
+    // Validate channel
+    if( canbuf_validateChannel(channel) == EXIT_FAILURE )
+    {
+        return 0;
+    }
+    count = 0;
+    for(lane = CAN_LANE_INTERACTIVE; lane < CAN_NUMBER_OF_LANES; lane++)
+    {
+        count += spscbuf_dataCount(canbufID[channel][CAN_WRITE_BUFFER + lane]);
+    }
+    return count;
+}
+
+/* Get the statistics of a write lane */
+int canbuf_getLaneStats(int channel, canLane_t lane, canbufLaneStats_t* stats, 
+        bool reset)
+{
+    // Validate channel and lane
+    if( (canbuf_validateChannel(channel) == EXIT_FAILURE) || 
+            (canbuf_validateLane(lane) == EXIT_FAILURE) )
+    {
+        return EXIT_FAILURE;
+    }
+    // LOCK STATS
+    pthread_mutex_lock(&cb_stats_mutex[channel]);
+    *stats = cb_laneStats[channel][lane];
+    if(reset)
+    {
+        memset(&cb_laneStats[channel][lane], 0, sizeof(canbufLaneStats_t));
+    }
+    // UNLOCK STATS
+    pthread_mutex_unlock(&cb_stats_mutex[channel]);
+    // LOCK WRITE: High-water mark (producers)
+    pthread_mutex_lock(&cb_write_mutex[channel][lane]);
+    stats->count = spscbuf_dataCount(
+            canbufID[channel][CAN_WRITE_BUFFER + lane]);
+    stats->highWaterMark = cb_laneHighWaterMark[channel][lane];
+    if(reset)
+    {
+        cb_laneHighWaterMark[channel][lane] = stats->count;
+    }
+    // UNLOCK WRITE:
+    pthread_mutex_unlock(&cb_write_mutex[channel][lane]);
+    return EXIT_SUCCESS;
+}
@@ -6,6 +6,36 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First Version: copied from HMSG 01.12                                    //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - Single record buffers (frame + timestamp) instead of DATA/STAMP pairs    //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Batched receive (recvmmsg) with tunable batch size and statistics        //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - Batched send (sendmmsg): unsent frames stay in the Write Buffer          //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - Read records are stamped with the kernel receive time in nanoseconds     //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - canbuf_enableEvents: eventfd signalled on buffer push                    //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - canbuf_setWriteMsgsToBuffer: several frames with a single lock           //
+//----------------------------------------------------------------------------//
+//  1.07     | 16/Oct/2026 |                               | ALCP             //
+// - canbuf_getWriteCount: frames waiting in the Write Buffer                 //
+//----------------------------------------------------------------------------//
+//  1.08     | 16/Oct/2026 |                               | ALCP             //
+// - Write lanes (interactive, control, background): strict priority          //
+//----------------------------------------------------------------------------//
+//  1.09     | 16/Oct/2026 |                               | ALCP             //
+// - canbufLaneStats_t: high-water mark sampled on push                       //
+//----------------------------------------------------------------------------//
+//  1.10     | 16/Oct/2026 |                               | ALCP             //
+// - Write lanes: interactive (actions, loads OFF), background (no control)   //
+//----------------------------------------------------------------------------//
 
 #ifndef CANBUF_H
 #define CANBUF_H
@@ -14,6 +44,8 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+#include <stdbool.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
     
@@ -21,25 +53,36 @@ extern "C" {
 // EXTERNAL DEFINITIONS
 //----------------------------------------------------------------------------//
 #define CAN_BUFFER_SIZE    600
+// Default number of frames read with a single syscall (1..SOCKETCAN_MAX_BATCH)
+#define CAN_RECEIVE_BATCH_SIZE  16
+// Maximum number of frames written with a single syscall (<= SOCKETCAN_MAX_BATCH)
+#define CAN_SEND_BATCH_SIZE     32
 enum
 {
     SOCKETCAN_CHANNEL_0 = 0, // First CAN channel
     // SOCKETCAN_CHANNEL_1, // Second CAN channel
     SOCKETCAN_CHANNELS
 };
+// Write lanes: one Write Buffer per priority (canbuf_send drains the first 
+// lane with frames - strict priority)
+typedef enum
+{
+    CAN_LANE_INTERACTIVE = 0,   // State machines (actions, loads OFF)
+    CAN_LANE_BACKGROUND,        // Polling (load status requests)
+    CAN_NUMBER_OF_LANES
+} canLane_t;
 enum
 {
-    CAN_READ_DATA_BUFFER = 0,
-    CAN_READ_STAMP_BUFFER,
-    CAN_WRITE_DATA_BUFFER,
-    CAN_WRITE_STAMP_BUFFER,
-    CAN_NUMBER_OF_BUFFERS
+    CAN_READ_BUFFER = 0,
+    CAN_WRITE_BUFFER,   // Write Buffer of a lane: CAN_WRITE_BUFFER + lane
+    CAN_NUMBER_OF_BUFFERS = CAN_WRITE_BUFFER + CAN_NUMBER_OF_LANES
 };
 
 //-------------------------------------------------------------------------//
 // EXTERNAL TYPES
 //-------------------------------------------------------------------------//
 // Send
+#define CAN_SEND_BUSY               2   // Transmit queue full: frames kept in buffer
 #define CAN_SEND_OK                 1
 #define CAN_SEND_NO_DATA            0
 #define CAN_SEND_BUFFER_ERROR       -1  // Re-Init and clean Buffers: canbuf_close(1)
@@ -58,6 +101,24 @@ typedef enum
   CAN_CONNECTED
 }stateCAN_t;
 
+// Buffer record: frame and timestamp are pushed / popped as a single element
+typedef struct
+{
+    struct can_frame frame;
+    uint64_t timestamp;     // Read: ns since epoch (kernel receive time)
+                            // Write: ms since epoch (enqueue time)
+} canbufRecord_t;
+
+// Write lane statistics
+typedef struct
+{
+    unsigned int count;                 // Frames waiting
+    unsigned int highWaterMark;         // Frames waiting (maximum on push)
+    unsigned long long frames;          // Frames sent
+    unsigned long long totalLatency;    // ms - enqueue to send (all frames)
+    unsigned long long maxLatency;      // ms - enqueue to send
+} canbufLaneStats_t;
+
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
@@ -70,6 +131,18 @@ typedef enum
  */
 int canbuf_init(int channel);
 
+/**
+ * Enable the push notifications of a CAN buffer: the returned eventfd is 
+ * signalled every time data is added to the buffer (to be used with poll / 
+ * epoll by the thread consuming the buffer). Call after canbuf_init and 
+ * before the threads start.
+ * \param   channel     Channel 0 (SOCKETCAN_CHANNEL_0): can0 
+ *                      Channel 1 (SOCKETCAN_CHANNEL_1): can1
+ * \param   buffer      CAN_READ_BUFFER / CAN_WRITE_BUFFER
+ * \return  eventfd (non-blocking) / -1 on error
+ */
+int canbuf_enableEvents(int channel, int buffer);
+
 /**
  * CAN Initialization - Socket Connection
  * \param   channel     Channel 0 (SOCKETCAN_CHANNEL_0): can0 
@@ -100,21 +173,47 @@ int canbuf_getState(int channel, stateCAN_t* scp_state);
 /**
  * Set Write buffer with data from parameters.
  * 
+ * \param   lane                    Write lane (priority)
  * \param   pcf_Frame
  * \param   millisecondsSinceEpoch
  * 
  * \return  CAN_SEND_OK                 if data was set to buffer
  *          CAN_SEND_BUFFER_ERROR       if no data was set due to buffer error
- *          CAN_SEND_PARAMETER_ERROR    if no data was set due to channel error
+ *          CAN_SEND_PARAMETER_ERROR    if no data was set due to channel or 
+ *                                      lane error
+ */
+int canbuf_setWriteMsgToBuffer(int channel, canLane_t lane, 
+        struct can_frame* pcf_Frame, unsigned long long millisecondsSinceEpoch);
+
+/**
+ * Set Write buffer with several frames at once (single lock, published in 
+ * batches - the frames are kept in order).
+ * 
+ * \param   lane                    Write lane (priority)
+ * \param   pcf_Frames              frames to be added
+ * \param   count                   number of frames
+ * \param   millisecondsSinceEpoch
+ * 
+ * \return  CAN_SEND_OK                 if all the frames were set to buffer
+ *          CAN_SEND_BUFFER_ERROR       if not all the frames were set (buffer)
+ *          CAN_SEND_PARAMETER_ERROR    if no data was set due to channel or 
+ *                                      lane error
  */
-int canbuf_setWriteMsgToBuffer(int channel, struct can_frame* pcf_Frame, unsigned long long millisecondsSinceEpoch);
+int canbuf_setWriteMsgsToBuffer(int channel, canLane_t lane, 
+        struct can_frame* pcf_Frames, int count, 
+        unsigned long long millisecondsSinceEpoch);
 
 /**
- * CAN Send Data from Write Buffer
+ * CAN Send Data from Write Buffer. Up to CAN_SEND_BATCH_SIZE frames are sent 
+ * with a single syscall; only the frames sent are removed from the buffer.
+ * The frames are taken from the first write lane with data (strict priority:
+ * interactive, background).
  * 
  * \param   channel     Channel 0 (SOCKETCAN_CHANNEL_0): can0 
  *                      Channel 1 (SOCKETCAN_CHANNEL_1): can1
- * \return  CAN_SEND_OK                 if data was sent
+ * \return  CAN_SEND_OK                 if data was sent (one or more frames)
+ *          CAN_SEND_BUSY               if no data was sent due to a full socket
+ *                                      transmit queue (data kept in buffer)
  *          CAN_SEND_NO_DATA            if no data available to be sent
  *          CAN_SEND_BUFFER_ERROR       if no data was sent due to buffer error
  *          CAN_SEND_SOCKET_ERROR       if no data was sent due to socket error
@@ -126,17 +225,20 @@ int canbuf_send(int channel);
  * Get data from Read buffer and set data from parameters.
  * 
  * \param   pcf_Frame
- * \param   millisecondsSinceEpoch
+ * \param   nanosecondsSinceEpoch   Kernel receive time (read time if the 
+ *                                  kernel timestamps are not available)
  * 
  * \return  CAN_RECEIVE_OK              if data was set to buffer
  *          CAN_RECEIVE_NO_DATA         if there is no data on the buffer
  *          CAN_RECEIVE_BUFFER_ERROR    if no data was set due to buffer error
  *          CAN_RECEIVE_PARAMETER_ERROR if no data was set due to channel error
  */
-int canbuf_getReadMsgFromBuffer(int channel, struct can_frame* pcf_Frame, unsigned long long* millisecondsSinceEpoch);
+int canbuf_getReadMsgFromBuffer(int channel, struct can_frame* pcf_Frame, unsigned long long* nanosecondsSinceEpoch);
 
 /**
- * CAN read Data and fill Read Buffer
+ * CAN read Data and fill Read Buffer. All frames available on the socket (up 
+ * to the receive batch size) are read with a single syscall and added to the 
+ * Read Buffer at once.
  * \param   timeout     timeout to wait for data on each channel in milliseconds
  *                      -1 equals to no timeout
  * \param   channel     Channel 0 (SOCKETCAN_CHANNEL_0): can0 
@@ -149,6 +251,47 @@ int canbuf_getReadMsgFromBuffer(int channel, struct can_frame* pcf_Frame, unsign
  */
 int canbuf_receive(int channel, int timeout);
 
+/**
+ * Set the maximum number of frames read from the socket with a single syscall
+ * by canbuf_receive (all channels).
+ * \param   frames      1..SOCKETCAN_MAX_BATCH (1 = no batch)
+ * \return  EXIT_SUCCESS / EXIT_FAILURE (out of range, nothing changed)
+ */
+int canbuf_setReceiveBatch(int frames);
+
+/**
+ * Get the receive statistics: frames read and read syscalls since start.
+ * Frames per syscall achieved = frames / syscalls.
+ * \param   channel     Channel 0 (SOCKETCAN_CHANNEL_0): can0 
+ *                      Channel 1 (SOCKETCAN_CHANNEL_1): can1
+ * \param   frames      Number of frames to be filled
+ * \param   syscalls    Number of read syscalls (with data) to be filled
+ * \return  EXIT_SUCCESS / EXIT_FAILURE
+ */
+int canbuf_getReceiveStats(int channel, unsigned long long* frames, 
+        unsigned long long* syscalls);
+
+/**
+ * Get the number of frames waiting in the Write Buffer (not sent yet - all 
+ * the lanes).
+ * \param   channel     Channel 0 (SOCKETCAN_CHANNEL_0): can0 
+ *                      Channel 1 (SOCKETCAN_CHANNEL_1): can1
+ * \return  number of frames (0 if wrong channel)
+ */
+unsigned int canbuf_getWriteCount(int channel);
+
+/**
+ * Get the statistics of a write lane (since start or the last reset).
+ * \param   channel     Channel 0 (SOCKETCAN_CHANNEL_0): can0 
+ *                      Channel 1 (SOCKETCAN_CHANNEL_1): can1
+ * \param   lane        Write lane
+ * \param   stats       Statistics to be filled
+ * \param   reset       true to restart the statistics
+ * \return  EXIT_SUCCESS / EXIT_FAILURE
+ */
+int canbuf_getLaneStats(int channel, canLane_t lane, canbufLaneStats_t* stats, 
+        bool reset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,9 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - "State Timeouts" section                                                 //
+//----------------------------------------------------------------------------//
 
 /*
 * Includes
@@ -85,6 +88,8 @@ static bool processStatesTransitions(char *line, csvconfigFileData* fileData,
     harpiStateTransitionsData* data);
 static bool processEventSets(char *line, csvconfigFileData* fileData, 
     harpiEventSetsData* data);
+static bool processStateTimeouts(char *line, csvconfigFileData* fileData, 
+    harpiStateTimeoutsData* data);
 static bool processField(char* field, csvconfig_field_type_t fieldtype, 
     int16_t* value);
 
@@ -330,6 +335,10 @@ static csvconfig_file_section_t getCSVSection(char *str)
     {
         section = CSV_SECTION_EVENT_SETS;
     }
+    else if (strcmp(str, "State Timeouts") == 0)
+    {
+        section = CSV_SECTION_STATE_TIMEOUTS;
+    }
     else
     {
         section = CSV_SECTION_OTHER;
@@ -413,6 +422,13 @@ static csvconfig_file_section_t processLine(char *line,
                     section = CSV_SECTION_OTHER;
                 }
                 break;
+            case CSV_SECTION_STATE_TIMEOUTS:
+                if(!processStateTimeouts(line, fileData, 
+                    &element.stateTimeoutsData))
+                {
+                    section = CSV_SECTION_OTHER;
+                }
+                break;
             default:
                 break;
         }
@@ -748,6 +764,67 @@ static bool processEventSets(char *line, csvconfigFileData* fileData,
     return ret;
 }
 
+/**
+ * Process lines for "State Timeouts": stateMachineID, stateID ("*" for all 
+ * the states of the state machine), timeout (ms)
+ **/
+static bool processStateTimeouts(char *line, csvconfigFileData* fileData, 
+    harpiStateTimeoutsData* data)
+{
+    char *token;
+    char *rest_of_line; // Context pointer for strtok_r
+    char *endptr;
+    bool ret = false;
+    int16_t val;
+    long timeout;
+    // initial position - line was processed with strtok_r a first time
+    rest_of_line = line;
+    //-------------------------
+    // Get fields
+    //-------------------------
+    // int16_t stateMachineID
+    token = strtok_r(rest_of_line, ",", &rest_of_line);
+    ret = processField(token, CSV_FIELD_TYPE_INT16, &val);
+    if(!ret)
+    {
+        return ret;
+    }
+    data->stateMachineID = val + fileData->last_maxStateMachineID;
+    if(data->stateMachineID > fileData->new_maxStateMachineID)
+    {
+        fileData->new_maxStateMachineID = data->stateMachineID;
+    }
+    // int16_t stateID
+    token = strtok_r(rest_of_line, ",", &rest_of_line);
+    if( (token != NULL) && (strcmp(token, "*") == 0) )
+    {
+        data->stateID = -1;
+    }
+    else
+    {
+        ret = processField(token, CSV_FIELD_TYPE_INT16, &val);
+        if(!ret)
+        {
+            return ret;
+        }
+        data->stateID = val;
+    }
+    // int32_t timeout - ms
+    token = strtok_r(rest_of_line, ",", &rest_of_line);
+    if(token == NULL)
+    {
+        return false;
+    }
+    timeout = strtol(token, &endptr, 10);
+    if( (endptr == token) || (*endptr != '\0') || (timeout > INT32_MAX) || 
+        (timeout < 0) )
+    {
+        return false;
+    }
+    data->timeout = (int32_t)timeout;
+    return ret;
+}
+
 static bool processField(char* field, csvconfig_field_type_t fieldtype, 
     int16_t* value)
 {
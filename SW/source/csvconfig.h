@@ -6,6 +6,9 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First Version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - CSV_SECTION_STATE_TIMEOUTS                                               //
+//----------------------------------------------------------------------------//
 
 
 #ifndef CSVCONFIG_H
@@ -36,6 +39,7 @@ typedef enum
     CSV_SECTION_STATES_AND_ACTIONS,
     CSV_SECTION_STATE_TRANSITIONS,
     CSV_SECTION_EVENT_SETS,
+    CSV_SECTION_STATE_TIMEOUTS,
     CSV_SECTION_OTHER,
 } csvconfig_file_section_t;
     
@@ -9,6 +9,12 @@
 //  1.01     | 30/Jul/2025 |                               | ALCP             //
 // - Updates to remove unused parts from HMSG 01.12                           //
 //----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - DEBUG_SCHEDULER_ERRORS                                                   //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - DEBUG_HARPILOADS_DISCOVERY                                               //
+//----------------------------------------------------------------------------//
 
 #ifndef DEBUG_H
 //#define DEBUG_H
@@ -39,6 +45,7 @@ extern "C" {
 /* CAN Buffer */
 #define DEBUG_CANBUF_ERRORS
 //#define DEBUG_CANBUF_SEND // Disable for production
+//#define DEBUG_CANBUF_RECEIVE_STATS // Frames per read syscall
 
 /* CAN DEBUG */   
 #define DEBUG_CAN_HAPCAN
@@ -56,12 +63,17 @@ extern "C" {
 
 /* HARPIACTIONS */
 #define DEBUG_HARPIEVENTS_ERRORS
+//#define DEBUG_HARPIEVENTS_BENCHMARK // Event set matchers (on start)
 
 /* HARPILOADS */
 #define DEBUG_HARPILOADS_ERRORS
+#define DEBUG_HARPILOADS_DISCOVERY // Time to full state
 
 /* HARPI STATE MACHINES*/
 #define DEBUG_HARPISM_ERRORS
+
+/* SCHEDULER */
+#define DEBUG_SCHEDULER_ERRORS // Late jobs (skipped periods)
     
 //----------------------------------------------------------------------------//
 // EXTERNAL TYPES
@@ -9,6 +9,9 @@
 //  1.01     | 30/Jul/2025 |                               | ALCP             //
 // - Updates to remove unused parts from HMSG 01.12                           //
 //----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - CAN_SEND_BUSY is not an error (frames are kept to be sent later)         //
+//----------------------------------------------------------------------------//
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,6 +48,7 @@ bool errorh_isError(errorh_module_t module, int error)
             switch(error)
             {
                 case CAN_SEND_OK:
+                case CAN_SEND_BUSY:
                 case CAN_SEND_NO_DATA:
                     ret = false;
                     break;                
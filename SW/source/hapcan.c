@@ -9,6 +9,18 @@
 //  1.01     | 30/Jul/2025 |                               | ALCP             //
 // - Updates to remove unused parts from HMSG 01.12                           //
 //----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - hapcan_addToCANWriteBufferN: batched CAN Write Buffer                    //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - hapcan_getCANWritePending                                                //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - Write Buffer lane (priority) per message                                 //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - hapcan_addCANFramesToWriteBuffer: frames already encoded                 //
+//----------------------------------------------------------------------------//
 
 /*
 * Includes
@@ -181,7 +193,7 @@ void hapcan_getSystemFrame(hapcanCANData *hd_result, uint16_t frametype,
 /**
  * Add a HAPCAN Message to the CAN Write Buffer
  */
-int hapcan_addToCANWriteBuffer(hapcanCANData* hapcanData, 
+int hapcan_addToCANWriteBuffer(hapcanCANData* hapcanData, canLane_t lane, 
         unsigned long long timestamp)
 {
     int check;
@@ -192,7 +204,7 @@ int hapcan_addToCANWriteBuffer(hapcanCANData* hapcanData,
     //---------------------------------    
     aux_clearCANFrame(&cf_Frame);
     hapcan_getCANDataFromHAPCAN(hapcanData, &cf_Frame);
-    check = canbuf_setWriteMsgToBuffer(0, &cf_Frame, timestamp);
+    check = canbuf_setWriteMsgToBuffer(0, lane, &cf_Frame, timestamp);
     // Check if error occurred when adding to buffer
     errorh_isError(ERROR_MODULE_CAN_SEND, check);
     if(check != CAN_SEND_OK)
@@ -207,4 +219,72 @@ int hapcan_addToCANWriteBuffer(hapcanCANData* hapcanData,
     }
     // return
     return ret;
+}
+
+int hapcan_addToCANWriteBufferN(hapcanCANData* hapcanData, int count, 
+        canLane_t lane, unsigned long long timestamp)
+{
+    int check;
+    int li_index;
+    int li_batch;
+    int li_added;
+    struct can_frame cf_Frames[HAPCAN_WRITE_BATCH];
+    //---------------------------------
+    // Add data to CAN Write Buffer (per batch)
+    //---------------------------------
+    for(li_added = 0; li_added < count; li_added += li_batch)
+    {
+        li_batch = count - li_added;
+        if(li_batch > HAPCAN_WRITE_BATCH)
+        {
+            li_batch = HAPCAN_WRITE_BATCH;
+        }
+        for(li_index = 0; li_index < li_batch; li_index++)
+        {
+            aux_clearCANFrame(&cf_Frames[li_index]);
+            hapcan_getCANDataFromHAPCAN(&hapcanData[li_added + li_index], 
+                &cf_Frames[li_index]);
+        }
+        check = canbuf_setWriteMsgsToBuffer(0, lane, cf_Frames, li_batch, 
+            timestamp);
+        // Check if error occurred when adding to buffer
+        errorh_isError(ERROR_MODULE_CAN_SEND, check);
+        if(check != CAN_SEND_OK)
+        {
+            // Here we have to set to error to inform the application to 
+            // restart CAN.
+            return HAPCAN_CAN_RESPONSE_ERROR;
+        }
+    }
+    return HAPCAN_CAN_RESPONSE;
+}
+
+/**
+ * Add several CAN frames (already encoded) to the CAN Write Buffer
+ */
+int hapcan_addCANFramesToWriteBuffer(struct can_frame* frames, int count, 
+        canLane_t lane, unsigned long long timestamp)
+{
+    int check;
+    //---------------------------------
+    // Add data to CAN Write Buffer (batches in canbuf)
+    //---------------------------------
+    check = canbuf_setWriteMsgsToBuffer(0, lane, frames, count, timestamp);
+    // Check if error occurred when adding to buffer
+    errorh_isError(ERROR_MODULE_CAN_SEND, check);
+    if(check != CAN_SEND_OK)
+    {
+        // Here we have to set to error to inform the application to 
+        // restart CAN.
+        return HAPCAN_CAN_RESPONSE_ERROR;
+    }
+    return HAPCAN_CAN_RESPONSE;
+}
+
+/**
+ * Get the number of messages waiting in the CAN Write Buffer
+ */
+unsigned int hapcan_getCANWritePending(void)
+{
+    return canbuf_getWriteCount(0);
 }
\ No newline at end of file
@@ -9,6 +9,18 @@
 //  1.01     | 30/Jul/2025 |                               | ALCP             //
 // - Updates to remove unused parts from HMSG 01.12                           //
 //----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - hapcan_addToCANWriteBufferN: batched CAN Write Buffer                    //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - hapcan_getCANWritePending                                                //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - Write Buffer lane (priority) per message                                 //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - hapcan_addCANFramesToWriteBuffer: frames already encoded                 //
+//----------------------------------------------------------------------------//
 
 #ifndef HAPCAN_H
 #define HAPCAN_H
@@ -21,6 +33,7 @@ extern "C" {
 #include <stdbool.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <canbuf.h>
 
 //----------------------------------------------------------------------------//
 // EXTERNAL DEFINITIONS
@@ -44,6 +57,8 @@ enum
 #define HAPCAN_FULL_FRAME_LEN 12
 // SOCKET  
 #define HAPCAN_MAX_RESPONSES 2
+// Frames converted and added to the CAN Write Buffer at once
+#define HAPCAN_WRITE_BATCH 64
 // FRAMES
 // Normal Messages - Application frames handled by the functional firmware
 #define HAPCAN_RGBW_FRAME_TYPE                  0x318
@@ -160,6 +175,7 @@ void hapcan_getSystemFrame(hapcanCANData *hd_result, uint16_t frametype,
 /**
  * Add a HAPCAN Message to the CAN Write Buffer
  * \param   hapcanData      (INPUT) HAPCAN Frame to be added to CAN write buffer
+ * \param   lane            (INPUT) Write lane (priority - see canbuf.h)
  * \param   timestamp       (INPUT) Timestamp
  * \param   sendToSocket    (INPUT) If the message has to be added to the socket
  *                              Write Buffer
@@ -168,9 +184,47 @@ void hapcan_getSystemFrame(hapcanCANData *hd_result, uint16_t frametype,
  *          HAPCAN_CAN_RESPONSE_ERROR: Error adding to MQTT Pub Buffer
  *          
  */
-int hapcan_addToCANWriteBuffer(hapcanCANData* hapcanData, 
+int hapcan_addToCANWriteBuffer(hapcanCANData* hapcanData, canLane_t lane, 
         unsigned long long timestamp);
 
+/**
+ * Add several HAPCAN Messages to the CAN Write Buffer (in order, one buffer 
+ * lock per HAPCAN_WRITE_BATCH messages)
+ * \param   hapcanData      (INPUT) HAPCAN Frames to be added to CAN write 
+ *                              buffer
+ * \param   count           (INPUT) Number of frames
+ * \param   lane            (INPUT) Write lane (priority - see canbuf.h)
+ * \param   timestamp       (INPUT) Timestamp
+ * 
+ * \return  HAPCAN_CAN_RESPONSE: All frames added to CAN Write Buffer (OK)
+ *          HAPCAN_CAN_RESPONSE_ERROR: Error adding to CAN Write Buffer
+ *          
+ */
+int hapcan_addToCANWriteBufferN(hapcanCANData* hapcanData, int count, 
+        canLane_t lane, unsigned long long timestamp);
+
+/**
+ * Add several CAN frames, already encoded (hapcan_getCANDataFromHAPCAN), to 
+ * the CAN Write Buffer (in order)
+ * \param   frames          (INPUT) CAN Frames to be added to CAN write buffer
+ * \param   count           (INPUT) Number of frames
+ * \param   lane            (INPUT) Write lane (priority - see canbuf.h)
+ * \param   timestamp       (INPUT) Timestamp
+ * 
+ * \return  HAPCAN_CAN_RESPONSE: All frames added to CAN Write Buffer (OK)
+ *          HAPCAN_CAN_RESPONSE_ERROR: Error adding to CAN Write Buffer
+ *          
+ */
+int hapcan_addCANFramesToWriteBuffer(struct can_frame* frames, int count, 
+        canLane_t lane, unsigned long long timestamp);
+
+/**
+ * Get the number of messages waiting in the CAN Write Buffer (not sent yet)
+ * 
+ * \return  number of messages
+ */
+unsigned int hapcan_getCANWritePending(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,27 @@
 //  1.00     | 01/Jun/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - harpi_enableEvents / harpi_handleEvents for the event driven manager     //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Immediate dispatch of CAN events (HARPI_IMMEDIATE_DISPATCH)              //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - IDs remapped to dense indexes on load (harpi_getIDCount / getOriginalID) //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - harpi_initBuffers: state machine shards created                          //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - State Timeouts section; timer_periodic every HARPI_PERIOD                //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - Periodic jobs (loads, timers) run by the scheduler                       //
+//----------------------------------------------------------------------------//
+//  1.07     | 16/Oct/2026 |                               | ALCP             //
+// - Timers: scheduler job at the next expiration (timer_createJob)           //
+//----------------------------------------------------------------------------//
 
 /*
 * Includes
@@ -24,6 +45,7 @@
 #include <harpievents.h>
 #include <harpiloads.h>
 #include <harpistatemachines.h>
+#include <scheduler.h>
 #include <timer.h>
 
 //----------------------------------------------------------------------------//
@@ -39,8 +61,11 @@
 //----------------------------------------------------------------------------//
 static pthread_mutex_t g_HarpiList_mutex = PTHREAD_MUTEX_INITIALIZER;
 static harpiLinkedList *head = NULL;
-static int16_t g_hloads_counter = 0;
-static int16_t g_timer_counter = 0;
+// Periodic jobs (scheduler)
+static int g_loadsJobID = SCHEDULER_ERROR;
+// Dense ID maps: index -> original (CSV) ID, sorted (built on load)
+static int16_t* g_idMap[HARPI_ID_TYPES];
+static int16_t g_idMapLen[HARPI_ID_TYPES];
 
 //----------------------------------------------------------------------------//
 // INTERNAL FUNCTIONS
@@ -49,6 +74,9 @@ static void clearElementData(harpiLinkedList* element);
 static void freeElementData(harpiLinkedList* element);
 static void addToHarpiLinkedList(harpiLinkedList* element);
 static int16_t deleteHarpiLinkedList(void);
+static int16_t* getIDField(harpiLinkedList* element, harpiIDType_t type);
+static int compareIDs(const void* a, const void* b);
+static bool remapIDs(void);
 
 // Clear all fields from a single element of the linked list //
 static void clearElementData(harpiLinkedList* element)
@@ -81,6 +109,10 @@ static void clearElementData(harpiLinkedList* element)
     element->stateTransitionsData.currentStateID = -1;
     element->stateTransitionsData.eventSetID = -1;
     element->stateTransitionsData.newStateID = -1;
+    // Init harpiStateTimeoutsData
+    element->stateTimeoutsData.stateMachineID = -1;
+    element->stateTimeoutsData.stateID = -1;
+    element->stateTimeoutsData.timeout = -1;
 }
 
 // Free allocated fields from a single element of the linked list //
@@ -136,6 +168,148 @@ static int16_t deleteHarpiLinkedList(void)
     return EXIT_SUCCESS;
 }
 
+// Get the ID field of a given type of an element (NULL if none)
+static int16_t* getIDField(harpiLinkedList* element, harpiIDType_t type)
+{
+    switch(element->section)
+    {
+        case CSV_SECTION_STATE_MACHINES_AND_LOADS:
+            if(type == HARPI_ID_STATE_MACHINE)
+            {
+                return &(element->smLoadsData.stateMachineID);
+            }
+            break;
+        case CSV_SECTION_STATE_MACHINES_AND_EVENTS:
+            if(type == HARPI_ID_STATE_MACHINE)
+            {
+                return &(element->smEventsData.stateMachineID);
+            }
+            if(type == HARPI_ID_EVENT_SET)
+            {
+                return &(element->smEventsData.eventSetID);
+            }
+            break;
+        case CSV_SECTION_ACTION_SETS:
+            if(type == HARPI_ID_ACTIONS_SET)
+            {
+                return &(element->actionSetsData.actionsSetID);
+            }
+            break;
+        case CSV_SECTION_EVENT_SETS:
+            if(type == HARPI_ID_EVENT_SET)
+            {
+                return &(element->eventSetsData.eventSetID);
+            }
+            break;
+        case CSV_SECTION_STATES_AND_ACTIONS:
+            if(type == HARPI_ID_STATE_MACHINE)
+            {
+                return &(element->stateActionsData.stateMachineID);
+            }
+            if(type == HARPI_ID_EVENT_SET)
+            {
+                return &(element->stateActionsData.eventSetID);
+            }
+            if(type == HARPI_ID_ACTIONS_SET)
+            {
+                return &(element->stateActionsData.actionsSetID);
+            }
+            break;
+        case CSV_SECTION_STATE_TRANSITIONS:
+            if(type == HARPI_ID_STATE_MACHINE)
+            {
+                return &(element->stateTransitionsData.stateMachineID);
+            }
+            if(type == HARPI_ID_EVENT_SET)
+            {
+                return &(element->stateTransitionsData.eventSetID);
+            }
+            break;
+        case CSV_SECTION_STATE_TIMEOUTS:
+            if(type == HARPI_ID_STATE_MACHINE)
+            {
+                return &(element->stateTimeoutsData.stateMachineID);
+            }
+            break;
+        default:
+            break;
+    }
+    return NULL;
+}
+
+// Compare IDs (qsort / bsearch)
+static int compareIDs(const void* a, const void* b)
+{
+    return (int)*(const int16_t*)a - (int)*(const int16_t*)b;
+}
+
+/* Replace the state machine, event set and actions set IDs of the linked 
+ * list by dense indexes (0..N-1 - sorted by ID), so the modules can index 
+ * their arrays with them. The original IDs are kept in g_idMap.
+ * (under g_HarpiList_mutex)
+ */
+static bool remapIDs(void)
+{
+    harpiIDType_t type;
+    harpiLinkedList* current;
+    int16_t* field;
+    int16_t* found;
+    int16_t len;
+    int16_t i;
+    bool isOK;
+    isOK = true;
+    for(type = HARPI_ID_STATE_MACHINE; type < HARPI_ID_TYPES; type++)
+    {
+        // Clear previous map
+        free(g_idMap[type]);
+        g_idMap[type] = NULL;
+        g_idMapLen[type] = 0;
+        // Get all IDs
+        len = 0;
+        for(current = head; current != NULL; current = current->next) 
+        {
+            len += (getIDField(current, type) != NULL);
+        }
+        g_idMap[type] = (int16_t*)malloc((len + 1) * sizeof(int16_t));
+        if(g_idMap[type] == NULL)
+        {
+            isOK = false;
+            continue;
+        }
+        for(current = head; current != NULL; current = current->next) 
+        {
+            field = getIDField(current, type);
+            if(field != NULL)
+            {
+                g_idMap[type][g_idMapLen[type]++] = *field;
+            }
+        }
+        // Sort and remove duplicates
+        qsort(g_idMap[type], g_idMapLen[type], sizeof(int16_t), compareIDs);
+        len = 0;
+        for(i = 0; i < g_idMapLen[type]; i++)
+        {
+            if( (i == 0) || (g_idMap[type][i] != g_idMap[type][len - 1]) )
+            {
+                g_idMap[type][len++] = g_idMap[type][i];
+            }
+        }
+        g_idMapLen[type] = len;
+        // Replace the IDs by their index
+        for(current = head; current != NULL; current = current->next) 
+        {
+            field = getIDField(current, type);
+            if(field != NULL)
+            {
+                found = (int16_t*)bsearch(field, g_idMap[type], 
+                    g_idMapLen[type], sizeof(int16_t), compareIDs);
+                *field = (int16_t)(found - g_idMap[type]);
+            }
+        }
+    }
+    return isOK;
+}
+
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
@@ -143,6 +317,29 @@ int harpi_initBuffers(void)
 {
     int check;
     check = harpievents_createBuffer();
+    if(check == EXIT_SUCCESS)
+    {
+        // State machine shards (workers)
+        check = harpism_createShards();
+    }
+    //---------------------------------------------
+    // Periodic jobs: absolute deadlines (no drift, missed periods skipped)
+    //---------------------------------------------
+    // Uninitialized loads - every HARPILOADS_PERIOD
+    if(g_loadsJobID == SCHEDULER_ERROR)
+    {
+        g_loadsJobID = scheduler_addPeriodic(HARPILOADS_PERIOD, 
+            harpiloads_periodic);
+    }
+    if(g_loadsJobID == SCHEDULER_ERROR)
+    {
+        check = EXIT_FAILURE;
+    }
+    // Timers (timing wheel - ms) - at their next expiration only
+    if(timer_createJob() == EXIT_FAILURE)
+    {
+        check = EXIT_FAILURE;
+    }
     return check;
 }
 
@@ -209,6 +406,10 @@ void harpi_addElementToList(harpiLinkedList* element)
             new_element.eventSetsData = element->eventSetsData;
             add_to_list = true;
             break;
+        case CSV_SECTION_STATE_TIMEOUTS:
+            new_element.stateTimeoutsData = element->stateTimeoutsData;
+            add_to_list = true;
+            break;
         case CSV_SECTION_OTHER:
             add_to_list = false;
             break;
@@ -251,6 +452,21 @@ int16_t harpi_getLinkedListNElements(csvconfig_file_section_t section)
 
 void harpi_load(void)
 {
+    bool isOK;
+    //---------------------------------------------
+    // Dense IDs - PROTECTED
+    //---------------------------------------------
+    // LOCK
+    pthread_mutex_lock(&g_HarpiList_mutex);
+    isOK = remapIDs();
+    // UNLOCK
+    pthread_mutex_unlock(&g_HarpiList_mutex);
+    if(!isOK)
+    {
+        #ifdef DEBUG_HARPIACTIONS_ERRORS
+        debug_print("harpi_load error - ID maps memory!\n");
+        #endif
+    }
     //---------------------------------------------
     // Init modules, load them - PROTECTED inside each module
     //---------------------------------------------
@@ -267,29 +483,75 @@ void harpi_load(void)
 
 void harpi_periodic(void)
 {
-    // Periodic check of uninitialized loads - every HARPILOADS_PERIOD
-    g_hloads_counter++;
-    if(g_hloads_counter > (int16_t)(HARPILOADS_PERIOD / HARPI_PERIOD))
+    // Periodic jobs due (loads, timers)
+    scheduler_run();
+    // Periodic check of state machines
+    harpism_periodic();
+}
+
+int16_t harpi_getIDCount(harpiIDType_t type)
+{
+    int16_t len;
+    len = 0;
+    // LOCK
+    pthread_mutex_lock(&g_HarpiList_mutex);
+    if( (type >= HARPI_ID_STATE_MACHINE) && (type < HARPI_ID_TYPES) )
     {
-        harpiloads_periodic();
-        g_hloads_counter = 0;
+        len = g_idMapLen[type];
     }
-    // Periodic timer update - every HARPITIMER_PERIOD
-    g_timer_counter++;
-    if(g_timer_counter > (int16_t)(HARPITIMER_PERIOD / HARPI_PERIOD))
+    // UNLOCK
+    pthread_mutex_unlock(&g_HarpiList_mutex);
+    return len;
+}
+
+int16_t harpi_getOriginalID(harpiIDType_t type, int16_t index)
+{
+    int16_t id;
+    id = -1;
+    // LOCK
+    pthread_mutex_lock(&g_HarpiList_mutex);
+    if( (type >= HARPI_ID_STATE_MACHINE) && (type < HARPI_ID_TYPES) && 
+        (index >= 0) && (index < g_idMapLen[type]) )
     {
-        timer_periodic();
-        g_timer_counter = 0;
+        id = g_idMap[type][index];
     }
-    // Periodic check of state machines
+    // UNLOCK
+    pthread_mutex_unlock(&g_HarpiList_mutex);
+    return id;
+}
+
+int harpi_enablePeriodic(void)
+{
+    return scheduler_enableEvents();
+}
+
+int harpi_enableEvents(void)
+{
+    return harpievents_enableEvents();
+}
+
+void harpi_handleEvents(void)
+{
+    // Check of state machines
     harpism_periodic();
 }
 
 void harpi_handleCAN(hapcanCANData* hapcanData, 
         unsigned long long timestamp)
 {
+    #ifdef HARPI_IMMEDIATE_DISPATCH
+    int count;
+    harpiEvent_t events[HARPIEVENTS_MAX_MATCH];
+    // Check for CAN Events
+    count = harpievents_matchCAN(hapcanData, events, HARPIEVENTS_MAX_MATCH);
+    // Update Loads and State Machine statuses
+    harpiloads_handleCAN(hapcanData, timestamp);
+    // Check state machines now (no wait for the periodic check)
+    harpism_handleEvents(events, count);
+    #else
     // Check for CAN Events
     harpievents_handleCAN(hapcanData, timestamp);
     // Update Loads and State Machine statuses
     harpiloads_handleCAN(hapcanData, timestamp);
+    #endif
 }
\ No newline at end of file
@@ -6,6 +6,24 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First Version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - harpi_enableEvents / harpi_handleEvents for the event driven manager     //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - HARPI_IMMEDIATE_DISPATCH                                                 //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - Dense ID maps: harpi_getIDCount / harpi_getOriginalID                    //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - harpiStateTimeoutsData: per state machine / state timeouts               //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - harpi_enablePeriodic: periodic jobs scheduled by deadline                //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - HARPILOADS_PERIOD: 50ms (load status discovery window)                   //
+//----------------------------------------------------------------------------//
 
 
 #ifndef HARPI_H
@@ -26,9 +44,15 @@ extern "C" {
 //----------------------------------------------------------------------------//
 // Timing
 #define HARPI_PERIOD 5000UL         // 5ms - See manager.c
-#define HARPILOADS_PERIOD 500000UL  // 500ms
-#define HARPITIMER_PERIOD 100000UL  // 100ms
-#define HARPI_STATE_WAIT_PERIOD 100 // 10s
+#define HARPILOADS_PERIOD 50000UL   // 50ms - see harpiloads.h
+// Default state timeout - ms (see "State Timeouts" in the CSV files)
+#define HARPI_STATE_WAIT_PERIOD 10000 // 10s
+/* Immediate dispatch: the state machines are checked by the thread handling 
+ * the CAN frame (harpi_handleCAN), right after the loads update. The periodic
+ * path is only used for timers and loads. Comment to queue the events to the
+ * periodic check (harpism_periodic).
+ */
+#define HARPI_IMMEDIATE_DISPATCH
 // Constraints
 #define MAXIMUM_ACTIONS 200 // No more than 200 actions per action ID
     
@@ -67,6 +91,15 @@ typedef enum
   HARPI_TIMER_UNAVAILABLE
 }harpiTimerStatus_t;
 
+// ID Type (dense ID maps)
+typedef enum
+{
+  HARPI_ID_STATE_MACHINE = 0,
+  HARPI_ID_EVENT_SET,
+  HARPI_ID_ACTIONS_SET,
+  HARPI_ID_TYPES
+}harpiIDType_t;
+
 // Event (for event processing)
 typedef struct  
 {
@@ -124,6 +157,14 @@ typedef struct
     int16_t newStateID;
 } harpiStateTransitionsData;
 
+// State Timeouts
+typedef struct  
+{
+    int16_t stateMachineID;
+    int16_t stateID;        // -1: all the states of the state machine
+    int32_t timeout;        // ms
+} harpiStateTimeoutsData;
+
 // Linked List Data
 typedef struct harpiLinkedList
 {
@@ -134,6 +175,7 @@ typedef struct harpiLinkedList
     harpiEventSetsData eventSetsData;
     harpiStateActionsData stateActionsData;
     harpiStateTransitionsData stateTransitionsData;
+    harpiStateTimeoutsData stateTimeoutsData;
     struct harpiLinkedList* next;
 } harpiLinkedList;
 
@@ -177,20 +219,67 @@ int16_t harpi_getLinkedListNElements(csvconfig_file_section_t section);
 /**
  * Init list and memory after all elements are added with the 
  * harpi_AddElementToList function.
+ * The state machine, event set and actions set IDs are replaced by dense 
+ * indexes (0..N-1, see harpi_getIDCount) before loading the modules.
  * 
  **/
 void harpi_load(void);
 
 /**
- * Periodic checks
+ * Get the number of IDs of a given type (valid indexes: 0..N-1)
+ * 
+ * \param   type    (INPUT) ID type
+ * 
+ * \return  number of IDs (N)
+ **/
+int16_t harpi_getIDCount(harpiIDType_t type);
+
+/**
+ * Get the original (CSV) ID of an index - diagnostics
+ * 
+ * \param   type    (INPUT) ID type
+ *          index   (INPUT) dense index
+ * 
+ * \return  original ID / -1 if not found
+ **/
+int16_t harpi_getOriginalID(harpiIDType_t type, int16_t index);
+
+/**
+ * Periodic checks: jobs due (loads, timers - see harpi_initBuffers) and 
+ * state machines
  * 
  **/
 void harpi_periodic(void);
 
+/**
+ * Enable the periodic notifications (event driven manager): the returned 
+ * timerfd is signalled when periodic checks are due (harpi_periodic).
+ * 
+ * \return  timerfd (non-blocking) / -1 on error
+ **/
+int harpi_enablePeriodic(void);
+
+/**
+ * Enable the new event notifications (event driven manager): the returned 
+ * eventfd is signalled when there are events to be handled with 
+ * harpi_handleEvents.
+ * 
+ * \return  eventfd (non-blocking) / -1 on error
+ **/
+int harpi_enableEvents(void);
+
+/**
+ * Handle the pending events (state machines) without the other periodic 
+ * checks.
+ * 
+ **/
+void harpi_handleEvents(void);
+
 /**
  * Check the CAN message received
  * \param   hapcanData      (INPUT) received HAPCAN Frame
- *          timestamp       (INPUT) Received message timestamp
+ *          timestamp       (INPUT) Received message timestamp (ns since
+ *                          epoch - kernel receive time)
  * 
  */
 void harpi_handleCAN(hapcanCANData* hapcanData, 
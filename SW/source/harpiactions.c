@@ -6,6 +6,24 @@
 //  1.00     | 01/Jun/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - Action sets grouped by the (dense) actionsSetID                          //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Frames to be sent kept per call (called by the state machine shards)     //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - harpiactions_getActionsFromID: frames sent later by the caller           //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - Actions sent on the interactive write lane                               //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - Action set frames encoded (struct can_frame) when loading                //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - Index cleared with the frames and on createIndex errors (locked)         //
+//----------------------------------------------------------------------------//
 
 /*
 * Includes
@@ -28,19 +46,30 @@
 //----------------------------------------------------------------------------//
 // INTERNAL TYPES
 //----------------------------------------------------------------------------//
+// Actions of an action set (harpiActionSetIndex index: actionsSetID)
+typedef struct  
+{
+    int16_t start;  // harpiActionFrames[start..start+count-1]
+    int16_t count;
+} haIndex_t;
 
 //----------------------------------------------------------------------------//
 // INTERNAL GLOBAL VARIABLES
 //----------------------------------------------------------------------------//
 static pthread_mutex_t g_ActionSets_mutex = PTHREAD_MUTEX_INITIALIZER;
+// Action sets from the linked list (only while loading)
 static harpiActionSetsData* harpiActionSetArray = NULL;
 static int16_t harpiActionSetArrayLen = 0;
-hapcanCANData frames[MAXIMUM_ACTIONS];
+// Frames of the actions grouped by action set, encoded for the CAN socket
+static struct can_frame* harpiActionFrames = NULL;
+static haIndex_t* harpiActionSetIndex = NULL;
+static int16_t harpiActionSetIndexLen = 0;
 
 //----------------------------------------------------------------------------//
 // INTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
 static bool copyListToArray(harpiLinkedList* element);
+static bool createIndex(void);
 
 // Copy from the Linked List to the Array
 static bool copyListToArray(harpiLinkedList* element)
@@ -74,6 +103,78 @@ static bool copyListToArray(harpiLinkedList* element)
     return isOK;
 }
 
+// Group the array by action set (same order inside each group), encode the 
+// frames and create the index (no index left on error)
+static bool createIndex(void)
+{
+    int16_t i;
+    int16_t id;
+    int16_t start;
+    struct can_frame* sorted;
+    // Clear index
+    if(harpiActionSetIndex != NULL)
+    {
+        free(harpiActionSetIndex);
+        harpiActionSetIndex = NULL;
+    }
+    harpiActionSetIndexLen = harpi_getIDCount(HARPI_ID_ACTIONS_SET);
+    if( (harpiActionSetIndexLen <= 0) || (harpiActionSetArrayLen <= 0) )
+    {
+        harpiActionSetIndexLen = 0;
+        return true;
+    }
+    harpiActionSetIndex = (haIndex_t*)calloc(harpiActionSetIndexLen, 
+        sizeof(haIndex_t));
+    sorted = (struct can_frame*)malloc(harpiActionSetArrayLen * 
+        sizeof(struct can_frame));
+    if( (harpiActionSetIndex == NULL) || (sorted == NULL) )
+    {
+        #ifdef DEBUG_HARPIACTIONS_ERRORS
+        debug_print("harpiactions_load error - index memory!\n");
+        #endif
+        free(sorted);
+        free(harpiActionSetIndex);
+        harpiActionSetIndex = NULL;
+        harpiActionSetIndexLen = 0;
+        return false;
+    }
+    // Count, get start positions and place
+    for(i = 0; i < harpiActionSetArrayLen; i++)
+    {
+        id = harpiActionSetArray[i].actionsSetID;
+        if( (id < 0) || (id >= harpiActionSetIndexLen) )
+        {
+            #ifdef DEBUG_HARPIACTIONS_ERRORS
+            debug_print("harpiactions_load error - action set ID!\n");
+            #endif
+            free(sorted);
+            free(harpiActionSetIndex);
+            harpiActionSetIndex = NULL;
+            harpiActionSetIndexLen = 0;
+            return false;
+        }
+        harpiActionSetIndex[id].count++;
+    }
+    start = 0;
+    for(i = 0; i < harpiActionSetIndexLen; i++)
+    {
+        harpiActionSetIndex[i].start = start;
+        start += harpiActionSetIndex[i].count;
+        harpiActionSetIndex[i].count = 0;
+    }
+    for(i = 0; i < harpiActionSetArrayLen; i++)
+    {
+        id = harpiActionSetArray[i].actionsSetID;
+        start = harpiActionSetIndex[id].start + harpiActionSetIndex[id].count;
+        aux_clearCANFrame(&(sorted[start]));
+        hapcan_getCANDataFromHAPCAN(&(harpiActionSetArray[i].frame), 
+            &(sorted[start]));
+        harpiActionSetIndex[id].count++;
+    }
+    harpiActionFrames = sorted;
+    return true;
+}
+
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
@@ -91,6 +192,19 @@ void harpiactions_init(void)
         harpiActionSetArray = NULL;
     }
     harpiActionSetArrayLen = 0;
+    // Init frames
+    if(harpiActionFrames != NULL)
+    {
+        free(harpiActionFrames);
+        harpiActionFrames = NULL;
+    }
+    // Init index
+    if(harpiActionSetIndex != NULL)
+    {
+        free(harpiActionSetIndex);
+        harpiActionSetIndex = NULL;
+    }
+    harpiActionSetIndexLen = 0;
     // UNLOCK
     pthread_mutex_unlock(&g_ActionSets_mutex);
 }
@@ -103,12 +217,24 @@ void harpiactions_load(harpiLinkedList* element)
     //---------------------------------------------
     // LOCK
     pthread_mutex_lock(&g_ActionSets_mutex);
-    // Clear array
+    // Clear arrays
     if(harpiActionSetArray != NULL)
     {
         free(harpiActionSetArray);
         harpiActionSetArray = NULL;
     }
+    if(harpiActionFrames != NULL)
+    {
+        free(harpiActionFrames);
+        harpiActionFrames = NULL;
+    }
+    // No index without frames (getActionsFromID)
+    if(harpiActionSetIndex != NULL)
+    {
+        free(harpiActionSetIndex);
+        harpiActionSetIndex = NULL;
+    }
+    harpiActionSetIndexLen = 0;
     // Get array size and allocate memory
     harpiActionSetArrayLen = harpi_getLinkedListNElements(
         CSV_SECTION_ACTION_SETS);
@@ -116,6 +242,14 @@ void harpiactions_load(harpiLinkedList* element)
         sizeof(harpiActionSetsData));
     // Create array from list
     isOK = copyListToArray(element);
+    // Group by action set and encode
+    if(isOK)
+    {
+        isOK = createIndex();
+    }
+    // The list data is not needed anymore
+    free(harpiActionSetArray);
+    harpiActionSetArray = NULL;
     // UNLOCK
     pthread_mutex_unlock(&g_ActionSets_mutex);
     // Clear data if copy had an error
@@ -125,62 +259,59 @@ void harpiactions_load(harpiLinkedList* element)
     }
 }
 
-void harpiactions_SendActionsFromID(int16_t actionsSetID)
+int16_t harpiactions_getActionsFromID(int16_t actionsSetID, 
+        struct can_frame* frames, int16_t maxFrames)
 {
-    int16_t check;
-    int16_t i;
-    unsigned long long millisecondsSinceEpoch;
     int16_t frameCount;
-    // Get Timestamp
-    millisecondsSinceEpoch = aux_getmsSinceEpoch();
-    //------------------------------------------------
-    // Avoid nested mutex locks from g_ActionSets_mutex and 
-    // hapcan_addToCANWriteBuffer: First create an array of frames to be sent, 
-    // then send them
-    //------------------------------------------------
-    // 1. Prepare frames to be sent - LOCK needed
-    //------------------------------------------------
     // Init counter
     frameCount = 0;
     // LOCK
     pthread_mutex_lock(&g_ActionSets_mutex);
-    // Check all elements of the array
-    for(i = 0; i < harpiActionSetArrayLen; i++)
+    // Actions of the action set (a single range)
+    if( (actionsSetID >= 0) && (actionsSetID < harpiActionSetIndexLen) )
     {
-        // Check for a match
-        if(harpiActionSetArray[i].actionsSetID == actionsSetID)
+        frameCount = harpiActionSetIndex[actionsSetID].count;
+        if(frameCount > maxFrames)
         {
-            // Add to frames to be sent
-            memcpy(&(frames[frameCount]), &(harpiActionSetArray[i].frame), 
-                sizeof(hapcanCANData));
-            frameCount++;
-            if(frameCount >= MAXIMUM_ACTIONS)
-            {
-                #ifdef DEBUG_HARPIACTIONS_ERRORS
-                debug_print("harpiactions_SendActionsFromID - ERROR: "
-                    "too many actions!\n");
-                #endif
-                break;
-            }
+            #ifdef DEBUG_HARPIACTIONS_ERRORS
+            debug_print("harpiactions_getActionsFromID - ERROR: "
+                "too many actions!\n");
+            #endif
+            frameCount = maxFrames;
         }
+        // Add to frames to be sent
+        memcpy(frames, 
+            &(harpiActionFrames[harpiActionSetIndex[actionsSetID].start]),
+            frameCount * sizeof(struct can_frame));
     }
     // UNLOCK
     pthread_mutex_unlock(&g_ActionSets_mutex);
-    //---------------------------------
-    // 2. Send Frames - LOCK not needed
-    //---------------------------------
-    // Check all elements of the array
-    for(i = 0; i < frameCount; i++)
-    {
-        // Found - Send CAN Frame for action
-        check = hapcan_addToCANWriteBuffer(&(frames[i]), 
-            millisecondsSinceEpoch);
-        if(check != HAPCAN_CAN_RESPONSE)
-        {
-            #ifdef DEBUG_HARPIACTIONS_ERRORS
-            debug_print("harpiactions_SendActionsFromID - ERROR: "
-                "hapcan_addToCANWriteBuffer!\n");
-            #endif
-        }
+    return frameCount;
+}
+
+void harpiactions_SendActionsFromID(int16_t actionsSetID)
+{
+    struct can_frame frames[MAXIMUM_ACTIONS];
+    int16_t frameCount;
+    int check;
+    //------------------------------------------------
+    // Avoid nested mutex locks from g_ActionSets_mutex and 
+    // hapcan_addCANFramesToWriteBuffer: First copy the (encoded) frames of the
+    // action set, then send them
+    //------------------------------------------------
+    frameCount = harpiactions_getActionsFromID(actionsSetID, frames, 
+        MAXIMUM_ACTIONS);
+    if(frameCount <= 0)
+    {
+        return;
+    }
+    check = hapcan_addCANFramesToWriteBuffer(frames, frameCount, 
+        CAN_LANE_INTERACTIVE, aux_getmsSinceEpoch());
+    if(check != HAPCAN_CAN_RESPONSE)
+    {
+        #ifdef DEBUG_HARPIACTIONS_ERRORS
+        debug_print("harpiactions_SendActionsFromID - ERROR: "
+            "hapcan_addCANFramesToWriteBuffer!\n");
+        #endif
     }
 }
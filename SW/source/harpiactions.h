@@ -6,6 +6,12 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - harpiactions_getActionsFromID: frames sent later by the caller           //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Action set frames encoded (struct can_frame) when loading                //
+//----------------------------------------------------------------------------//
 
 #ifndef HARPIACTIONS_H
 #define HARPIACTIONS_H
@@ -54,6 +60,19 @@ void harpiactions_load(harpiLinkedList* element);
  **/
 void harpiactions_SendActionsFromID(int16_t actionsSetID);
 
+/**
+ * Get the frames of an action set, encoded for the CAN socket (to be sent by 
+ * the caller - see harpiactions_SendActionsFromID)
+ * 
+ * \param   actionsSetID    (INPUT) The action set ID
+ *          frames          (OUTPUT) frames to be sent
+ *          maxFrames       (INPUT) size of "frames"
+ * 
+ * \return  number of frames
+ **/
+int16_t harpiactions_getActionsFromID(int16_t actionsSetID, 
+        struct can_frame* frames, int16_t maxFrames);
+
 
 #ifdef __cplusplus
 }
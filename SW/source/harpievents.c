@@ -6,6 +6,30 @@
 //  1.00     | 01/Jun/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - Events buffer created with fixed element size                            //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - harpievents_enableEvents: eventfd signalled on new events                //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - harpievents_matchCAN: matched events returned for immediate dispatch     //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - Event sets indexed by the header bytes pinned with 'e' + frametype bitmap//
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - Event sets compiled to planes (structure of arrays) - vector matching    //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - Event sets table published as a snapshot: lock-free matching             //
+//----------------------------------------------------------------------------//
+//  1.07     | 16/Oct/2026 |                               | ALCP             //
+// - harpievents_getEvents: pending events drained at once                    //
+//----------------------------------------------------------------------------//
+//  1.08     | 16/Oct/2026 |                               | ALCP             //
+// - Typed events queue: overflow policy and statistics                       //
+//----------------------------------------------------------------------------//
 
 /*
 * Includes
@@ -17,36 +41,169 @@
 #include <stdbool.h>
 #include <limits.h>
 #include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <sys/eventfd.h>
 #include <auxiliary.h>
-#include <buffer.h>
 #include <debug.h>
 #include <harpievents.h>
 
 //----------------------------------------------------------------------------//
 // INTERNAL DEFINITIONS
 //----------------------------------------------------------------------------//
-#define HARPI_EVENTS_BUFFER_SIZE 60
+// HAPCAN frame types (12 bits) - bitmap size in bytes
+#define HARPI_EVENTS_FRAMETYPES 4096
+#define HARPI_EVENTS_BITMAP_LEN (HARPI_EVENTS_FRAMETYPES / 8)
+// Compiled sets checked at once (vector lanes - one bit each in the result)
+#define HARPI_EVENTS_LANES 16
+// GCC vector extensions (SSE2 / NEON) - scalar code otherwise
+#if defined(__GNUC__) && !defined(HARPIEVENTS_SCALAR)
+#define HARPI_EVENTS_VECTOR
+#endif
+// Wait for the readers of a replaced table (us)
+#define HARPI_EVENTS_RECLAIM_WAIT 100
+#ifdef DEBUG_HARPIEVENTS_BENCHMARK
+#define HARPI_EVENTS_BENCHMARK_FRAMES 20000
+#endif
 
 //----------------------------------------------------------------------------//
 // INTERNAL TYPES
 //----------------------------------------------------------------------------//
+/* Index keys: header bytes (frame bytes 0..3) pinned with 'e' by the set
+ * - HEADER: frametype + flags, module and group (bytes 0..3)
+ * - FRAMETYPE: frametype + flags only (bytes 0..1)
+ * - NONE: not indexed - checked for every frame
+ */
+typedef enum
+{
+    HARPI_EVENT_KEY_HEADER = 0,
+    HARPI_EVENT_KEY_FRAMETYPE,
+    HARPI_EVENT_KEY_NONE
+}harpiEventKeyType_t;
+
+// Hash bucket: sets with the same key are in positions start..start+count-1
+typedef struct
+{
+    uint32_t key;
+    int16_t start;
+    int16_t count;  // 0: empty bucket
+} harpiEventBucket_t;
+
+// Hash index (open addressing)
+typedef struct
+{
+    harpiEventBucket_t* buckets;
+    uint32_t mask;  // buckets - 1 (power of 2)
+} harpiEventIndex_t;
+
+// Key of one event set (used to build the index)
+typedef struct
+{
+    uint32_t key;
+    harpiEventKeyType_t type;
+    int16_t set;
+} harpiEventKey_t;
+
+/* Event sets compiled to a structure of arrays (one plane per frame byte),
+ * sorted by index key. Frame byte "b" matches the set in position "p" if:
+ *   lo[b][p] <= b <= hi[b][p]  and NOT (ne[b][p] and b == neVal[b][p])
+ * - 'x': 0..255        - 'e': f..f         - 'n': 0..255, ne
+ * - '<': 0..f          - '>': f..255       - unknown: 255..0 (never)
+ */
+typedef struct
+{
+    uint8_t* lo[HAPCAN_FULL_FRAME_LEN];
+    uint8_t* hi[HAPCAN_FULL_FRAME_LEN];
+    uint8_t* ne[HAPCAN_FULL_FRAME_LEN];     // 0xFF: has to be different
+    uint8_t* neVal[HAPCAN_FULL_FRAME_LEN];
+    uint8_t* data;  // all planes (one block)
+    int16_t* set;   // position -> sets index
+    int16_t len;    // planes are padded with HARPI_EVENTS_LANES positions
+} harpiEventPlanes_t;
+
+/* Event sets table (built on load): never changed once published, replaced
+ * as a whole on reload (see tableAcquire / tablePublish)
+ */
+typedef struct
+{
+    harpiEventSetsData* sets;   // configuration order
+    int16_t setsLen;
+    harpiEventIndex_t index[HARPI_EVENT_KEY_NONE];
+    int16_t otherStart;         // not indexed sets (positions)
+    int16_t otherLen;
+    harpiEventPlanes_t planes;
+    uint8_t frametypeBitmap[HARPI_EVENTS_BITMAP_LEN];
+} harpiEventTable_t;
+
+#ifdef HARPI_EVENTS_VECTOR
+typedef uint8_t harpiEventVector_t 
+    __attribute__((vector_size(HARPI_EVENTS_LANES)));
+typedef int8_t harpiEventVectorMask_t 
+    __attribute__((vector_size(HARPI_EVENTS_LANES)));
+#endif
+
+// Events queue: preallocated ring (oldest event: events[head])
+typedef struct
+{
+    harpiEvent_t* events;
+    unsigned int capacity;
+    unsigned int head;
+    unsigned int count;
+    harpiEventsStats_t stats;
+} harpiEventsQueue_t;
 
 //----------------------------------------------------------------------------//
 // INTERNAL GLOBAL VARIABLES
 //----------------------------------------------------------------------------//
 static pthread_mutex_t g_EventSets_mutex = PTHREAD_MUTEX_INITIALIZER;
-static harpiEventSetsData* harpiEventSetArray = NULL;
-static int16_t harpiEventSetArrayLen = 0;
-static int harpiEventsBufferID = -1;
+static int harpiEventsFD = -1;
+// Events queue (condition: room available - HARPIEVENTS_OVERFLOW_BLOCK)
+static pthread_mutex_t g_EventsQueue_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_EventsQueue_cond = PTHREAD_COND_INITIALIZER;
+static harpiEventsQueue_t g_eventsQueue;
+/* Published table (NULL: no event sets). Readers are counted per epoch: a
+ * replaced table is freed once the readers of both epochs are done.
+ */
+static _Atomic(harpiEventTable_t*) g_eventTable = NULL;
+static atomic_uint g_eventEpoch = 0;
+static atomic_int g_eventReaders[2];
 
 //----------------------------------------------------------------------------//
 // INTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
-static bool copyListToArray(harpiLinkedList* element);
-static bool isMatch(harpiEventSetsData* set, hapcanCANData* hapcanData);
+static bool copyListToArray(harpiEventTable_t* table, 
+    harpiLinkedList* element);
+static int queuePush(harpiEvent_t* events, int count);
+static int queuePop(harpiEvent_t* events, int maxEvents);
+static bool isByteMatch(uint8_t condition, uint8_t filter, uint8_t value);
+static harpiEventKeyType_t getKey(harpiEventSetsData* set, uint32_t* key);
+static uint32_t hashKey(uint32_t key);
+static int compareKeys(const void* a, const void* b);
+static void setFrametypes(harpiEventTable_t* table, harpiEventSetsData* set);
+static void compileSet(harpiEventTable_t* table, int16_t pos, 
+    harpiEventSetsData* set);
+static void freeTable(harpiEventTable_t* table);
+static bool buildIndex(harpiEventTable_t* table);
+static int16_t lookupIndex(harpiEventIndex_t* index, uint32_t key, 
+    int16_t* count);
+static uint32_t matchBlock(harpiEventTable_t* table, int16_t pos, 
+    uint8_t* frame);
+static int matchRange(harpiEventTable_t* table, int16_t start, int16_t len, 
+    uint8_t* frame, int16_t* sets, int maxSets);
+static harpiEventTable_t* tableAcquire(unsigned int* epoch);
+static void tableRelease(unsigned int epoch);
+static void tablePublish(harpiEventTable_t* table);
+#ifdef DEBUG_HARPIEVENTS_BENCHMARK
+static bool isMatch(harpiEventSetsData* set, uint8_t* frame);
+static int linearMatchCAN(harpiEventTable_t* table, hapcanCANData* hapcanData);
+static void benchmarkSet(harpiEventSetsData* set);
+static void benchmarkFrame(harpiEventTable_t* table, 
+    hapcanCANData* hapcanData);
+#endif
 
 // Copy from the Linked List to the Array
-static bool copyListToArray(harpiLinkedList* element)
+static bool copyListToArray(harpiEventTable_t* table, 
+    harpiLinkedList* element)
 {
     int16_t i;
     harpiLinkedList* current;
@@ -60,7 +217,7 @@ static bool copyListToArray(harpiLinkedList* element)
         {
             if(current->section == CSV_SECTION_EVENT_SETS)
             {
-                if(i >= harpiEventSetArrayLen)
+                if(i >= table->setsLen)
                 {
                     #ifdef DEBUG_HARPIEVENTS_ERRORS
                     debug_print("harpievents_load error!\n");
@@ -68,7 +225,7 @@ static bool copyListToArray(harpiLinkedList* element)
                     isOK = false;
                     break;
                 }
-                memcpy(&(harpiEventSetArray[i]), &(current->eventSetsData), 
+                memcpy(&(table->sets[i]), &(current->eventSetsData), 
                     sizeof(harpiEventSetsData));
                 i++;
             }
@@ -77,75 +234,678 @@ static bool copyListToArray(harpiLinkedList* element)
     return isOK;
 }
 
-// Check for a match between event set data and a given hapcan frame
-static bool isMatch(harpiEventSetsData* set, hapcanCANData* hapcanData)
+// Check a single frame byte against the filter byte
+static bool isByteMatch(uint8_t condition, uint8_t filter, uint8_t value)
 {
     bool match;
-    int16_t i;
-    uint8_t frame[HAPCAN_FULL_FRAME_LEN];
-    // Get byte array from HAPCAN Frame
-    aux_getBytesFromHAPCAN(hapcanData, frame);
-    //-----------------------------------------
-    // Check the frame against the event frame
-    //-----------------------------------------
     // 'x': CAN byte doesn't need checking to FILTER byte (always matched)
     // 'e':	CAN byte must be identical to FILTER byte (CANx=FILx)
     // 'n':	CAN byte must be different than FILTER byte (CANx!=FILx)
     // '<':	CAN byte must be less or equal to FILTER byte (CANx<=FILx)
     // '>':	CAN byte must be greater or equal to FILTER byte (CANx>=FILx)
-    match = true;
+    switch(condition)
+    {
+        case 'x':
+            // Filter condition "x": byte doesn't need checking
+            match = true;
+            break;
+        case 'e':
+            // Filter condition "=": has to be equal
+            match = (value == filter);
+            break;
+        case 'n':
+            // Filter condition: "n": has to be different
+            match = (value != filter);
+            break;
+        case '<':
+            // Filter condition: "<": has to be smaller or equal
+            match = (value <= filter);
+            break;
+        case '>':
+            // Filter condition: ">": has to be higher or equal
+            match = (value >= filter);
+            break;
+        default:
+            // Unknown condition - Not matched
+            match = false;
+            break;
+    }
+    return match;
+}
+
+// Get the index key of an event set (header bytes pinned with 'e')
+static harpiEventKeyType_t getKey(harpiEventSetsData* set, uint32_t* key)
+{
+    uint8_t* c = set->fiterCondition;
+    uint8_t* f = set->fiter;
+    if( (c[0] != 'e') || (c[1] != 'e') )
+    {
+        *key = 0;
+        return HARPI_EVENT_KEY_NONE;
+    }
+    if( (c[2] == 'e') && (c[3] == 'e') )
+    {
+        *key = ((uint32_t)f[0] << 24) | ((uint32_t)f[1] << 16) | 
+            ((uint32_t)f[2] << 8) | (uint32_t)f[3];
+        return HARPI_EVENT_KEY_HEADER;
+    }
+    *key = ((uint32_t)f[0] << 8) | (uint32_t)f[1];
+    return HARPI_EVENT_KEY_FRAMETYPE;
+}
+
+// Hash (Fibonacci hashing) - the index mask selects the bucket
+static uint32_t hashKey(uint32_t key)
+{
+    key = key * 2654435761U;
+    return key ^ (key >> 16);
+}
+
+// Sort keys: by type, key, then by set index (keeps the configuration order)
+static int compareKeys(const void* a, const void* b)
+{
+    const harpiEventKey_t* ka = a;
+    const harpiEventKey_t* kb = b;
+    if(ka->type != kb->type)
+    {
+        return (ka->type < kb->type) ? -1 : 1;
+    }
+    if(ka->key != kb->key)
+    {
+        return (ka->key < kb->key) ? -1 : 1;
+    }
+    return (int)ka->set - (int)kb->set;
+}
+
+/* Set the bitmap bits of all frametypes an event set can match. Frame byte 0
+ * is frametype bits 11..4, byte 1 is frametype bits 3..0 + flags.
+ */
+static void setFrametypes(harpiEventTable_t* table, harpiEventSetsData* set)
+{
+    int hi;
+    int lo;
+    int frametype;
+    bool match;
+    uint8_t c1 = set->fiterCondition[1];
+    uint8_t f1 = set->fiter[1];
+    for(hi = 0; hi <= 0xFF; hi++)
+    {
+        if(!isByteMatch(set->fiterCondition[0], set->fiter[0], (uint8_t)hi))
+        {
+            continue;
+        }
+        for(lo = 0; lo <= 0x0F; lo++)
+        {
+            // Any flags value (low nibble of byte 1) may match
+            switch(c1)
+            {
+                case 'x':
+                case 'n':
+                    match = true;
+                    break;
+                case 'e':
+                    match = ((f1 >> 4) == lo);
+                    break;
+                case '<':
+                    match = ((lo << 4) <= f1);
+                    break;
+                case '>':
+                    match = (((lo << 4) | 0x0F) >= f1);
+                    break;
+                default:
+                    match = false;
+                    break;
+            }
+            if(match)
+            {
+                frametype = (hi << 4) | lo;
+                table->frametypeBitmap[frametype >> 3] |= (uint8_t)(1 << 
+                    (frametype & 0x07));
+            }
+        }
+    }
+}
+
+// Compile an event set to the planes (position "pos")
+static void compileSet(harpiEventTable_t* table, int16_t pos, 
+    harpiEventSetsData* set)
+{
+    int16_t i;
+    uint8_t f;
     for(i = 0; i < HAPCAN_FULL_FRAME_LEN; i++)
     {
+        f = set->fiter[i];
+        table->planes.lo[i][pos] = 0x00;
+        table->planes.hi[i][pos] = 0xFF;
+        table->planes.ne[i][pos] = 0x00;
+        table->planes.neVal[i][pos] = 0x00;
         switch(set->fiterCondition[i])
         {
             case 'x':
-                // Filter condition "x": byte doesn't need checking
                 break;
             case 'e':
-                // Filter condition "=": has to be equal
-                if(frame[i] != set->fiter[i])
-                {
-                    // Not matched
-                    match = false;
-                }
+                table->planes.lo[i][pos] = f;
+                table->planes.hi[i][pos] = f;
                 break;
             case 'n':
-                // Filter condition: "n": has to be different
-                if(frame[i] == set->fiter[i])
-                {
-                    // Not matched
-                    match = false;
-                }
+                table->planes.ne[i][pos] = 0xFF;
+                table->planes.neVal[i][pos] = f;
                 break;
             case '<':
-                // Filter condition: "<": has to be smaller or equal
-                if(frame[i] > set->fiter[i])
-                {
-                    // Not matched
-                    match = false;
-                }
+                table->planes.hi[i][pos] = f;
                 break;
             case '>':
-                // Filter condition: ">": has to be higher or equal
-                if(frame[i] < set->fiter[i])
-                {
-                    // Not matched
-                    match = false;
-                }
+                table->planes.lo[i][pos] = f;
                 break;
             default:
-                // Unknown condition - Not matched
-                match = false;
+                // Unknown condition - Never matched (lo > hi)
+                table->planes.lo[i][pos] = 0xFF;
+                table->planes.hi[i][pos] = 0x00;
                 break;
         }
-        if(!match)
+    }
+    table->planes.set[pos] = (int16_t)(set - table->sets);
+}
+
+// Free a table (not published or without readers)
+static void freeTable(harpiEventTable_t* table)
+{
+    int i;
+    if(table == NULL)
+    {
+        return;
+    }
+    for(i = 0; i < HARPI_EVENT_KEY_NONE; i++)
+    {
+        free(table->index[i].buckets);
+    }
+    free(table->planes.data);
+    free(table->planes.set);
+    free(table->sets);
+    free(table);
+}
+
+// Build the index from the table sets (table not published yet)
+static bool buildIndex(harpiEventTable_t* table)
+{
+    int16_t i;
+    int16_t j;
+    int16_t nKeys[HARPI_EVENT_KEY_NONE + 1];
+    int16_t len;
+    uint32_t size;
+    uint32_t h;
+    harpiEventKeyType_t type;
+    harpiEventKey_t* keys;
+    harpiEventIndex_t* index;
+    bool isOK;
+    //-----------------------------------------
+    // Keys (sorted) and frametype bitmap
+    //-----------------------------------------
+    keys = malloc((table->setsLen + 1) * sizeof(harpiEventKey_t));
+    if(keys == NULL)
+    {
+        #ifdef DEBUG_HARPIEVENTS_ERRORS
+        debug_print("harpievents_load error - Index memory!\n");
+        #endif
+        return false;
+    }
+    for(i = 0; i < table->setsLen; i++)
+    {
+        keys[i].type = getKey(&table->sets[i], &keys[i].key);
+        keys[i].set = i;
+        setFrametypes(table, &table->sets[i]);
+    }
+    qsort(keys, table->setsLen, sizeof(harpiEventKey_t), compareKeys);
+    //-----------------------------------------
+    // Planes: sets compiled in key order (padded for the last vector)
+    //-----------------------------------------
+    len = table->setsLen;
+    table->planes.data = calloc((size_t)(len + HARPI_EVENTS_LANES) * 4 * 
+        HAPCAN_FULL_FRAME_LEN, sizeof(uint8_t));
+    table->planes.set = calloc(len + HARPI_EVENTS_LANES, sizeof(int16_t));
+    isOK = (table->planes.data != NULL) && (table->planes.set != NULL);
+    if(isOK)
+    {
+        for(i = 0; i < HAPCAN_FULL_FRAME_LEN; i++)
+        {
+            table->planes.lo[i] = &table->planes.data[(4 * i + 0) * 
+                (len + HARPI_EVENTS_LANES)];
+            table->planes.hi[i] = &table->planes.data[(4 * i + 1) * 
+                (len + HARPI_EVENTS_LANES)];
+            table->planes.ne[i] = &table->planes.data[(4 * i + 2) * 
+                (len + HARPI_EVENTS_LANES)];
+            table->planes.neVal[i] = &table->planes.data[(4 * i + 3) * 
+                (len + HARPI_EVENTS_LANES)];
+        }
+        for(i = 0; i < len; i++)
         {
-            // Leave as soon as a mismatch is detected
+            compileSet(table, i, &table->sets[keys[i].set]);
+        }
+        table->planes.len = len;
+    }
+    //-----------------------------------------
+    // Hash tables: one bucket per key
+    //-----------------------------------------
+    memset(nKeys, 0, sizeof(nKeys));
+    for(i = 0; i < len; i++)
+    {
+        if( (i == 0) || (keys[i].type != keys[i - 1].type) || 
+            (keys[i].key != keys[i - 1].key) )
+        {
+            nKeys[keys[i].type]++;
+        }
+    }
+    for(type = HARPI_EVENT_KEY_HEADER; isOK && (type < HARPI_EVENT_KEY_NONE); 
+        type++)
+    {
+        if(nKeys[type] == 0)
+        {
+            continue;
+        }
+        // Table size: power of 2, at least twice the number of keys
+        size = 2;
+        while(size < (2U * (uint32_t)nKeys[type]))
+        {
+            size = size << 1;
+        }
+        table->index[type].buckets = calloc(size, sizeof(harpiEventBucket_t));
+        isOK = (table->index[type].buckets != NULL);
+        table->index[type].mask = size - 1;
+    }
+    for(i = 0; isOK && (i < len); i = j)
+    {
+        // Sets with the same key
+        for(j = i; (j < len) && (keys[j].type == keys[i].type) && 
+            (keys[j].key == keys[i].key); j++)
+        {
+        }
+        if(keys[i].type == HARPI_EVENT_KEY_NONE)
+        {
+            // Not indexed sets: always the last ones
+            table->otherStart = i;
+            table->otherLen = len - i;
             break;
         }
+        index = &table->index[keys[i].type];
+        h = hashKey(keys[i].key) & index->mask;
+        while(index->buckets[h].count != 0)
+        {
+            h = (h + 1) & index->mask;
+        }
+        index->buckets[h].key = keys[i].key;
+        index->buckets[h].start = i;
+        index->buckets[h].count = j - i;
+    }
+    free(keys);
+    if(!isOK)
+    {
+        #ifdef DEBUG_HARPIEVENTS_ERRORS
+        debug_print("harpievents_load error - Index memory!\n");
+        #endif
+    }
+    return isOK;
+}
+
+// Get the positions for a given key (returns start, count 0 if none)
+static int16_t lookupIndex(harpiEventIndex_t* index, uint32_t key, 
+    int16_t* count)
+{
+    uint32_t h;
+    *count = 0;
+    if(index->buckets == NULL)
+    {
+        return 0;
+    }
+    h = hashKey(key) & index->mask;
+    while(index->buckets[h].count != 0)
+    {
+        if(index->buckets[h].key == key)
+        {
+            *count = index->buckets[h].count;
+            return index->buckets[h].start;
+        }
+        h = (h + 1) & index->mask;
+    }
+    return 0;
+}
+
+// Match a frame against the HARPI_EVENTS_LANES sets starting at position "pos"
+// Returns the match bitset (bit n set: position pos + n matched)
+static uint32_t matchBlock(harpiEventTable_t* table, int16_t pos, 
+    uint8_t* frame)
+{
+    int16_t i;
+    uint32_t bits;
+    #ifdef HARPI_EVENTS_VECTOR
+    harpiEventVector_t lo;
+    harpiEventVector_t hi;
+    harpiEventVector_t ne;
+    harpiEventVector_t neVal;
+    harpiEventVector_t value;
+    harpiEventVectorMask_t match;
+    uint64_t lanes[HARPI_EVENTS_LANES / sizeof(uint64_t)];
+    match = ~(harpiEventVectorMask_t){0};
+    for(i = 0; i < HAPCAN_FULL_FRAME_LEN; i++)
+    {
+        // Planes are not aligned to the vector size (bucket start)
+        memcpy(&lo, &table->planes.lo[i][pos], sizeof(lo));
+        memcpy(&hi, &table->planes.hi[i][pos], sizeof(hi));
+        memcpy(&ne, &table->planes.ne[i][pos], sizeof(ne));
+        memcpy(&neVal, &table->planes.neVal[i][pos], sizeof(neVal));
+        value = (harpiEventVector_t){0} + frame[i];
+        match &= (value >= lo) & (value <= hi) & 
+            ~((value == neVal) & (harpiEventVectorMask_t)ne);
+        // Leave as soon as all the sets are mismatched
+        memcpy(lanes, &match, sizeof(lanes));
+        if( (lanes[0] | lanes[1]) == 0 )
+        {
+            return 0;
+        }
+    }
+    bits = 0;
+    for(i = 0; i < HARPI_EVENTS_LANES; i++)
+    {
+        if(match[i] != 0)
+        {
+            bits |= 1U << i;
+        }
+    }
+    #else
+    int16_t lane;
+    int16_t p;
+    uint8_t value;
+    bits = (1U << HARPI_EVENTS_LANES) - 1;
+    for(i = 0; (i < HAPCAN_FULL_FRAME_LEN) && (bits != 0); i++)
+    {
+        value = frame[i];
+        for(lane = 0; lane < HARPI_EVENTS_LANES; lane++)
+        {
+            p = pos + lane;
+            if( (value < table->planes.lo[i][p]) || 
+                (value > table->planes.hi[i][p]) ||
+                ( (table->planes.ne[i][p] != 0) && 
+                (value == table->planes.neVal[i][p]) ) )
+            {
+                bits &= ~(1U << lane);
+            }
+        }
+    }
+    #endif
+    return bits;
+}
+
+// Match a frame against the positions start..start+len-1
+// Returns the number of matched sets ("sets" filled in ascending order)
+static int matchRange(harpiEventTable_t* table, int16_t start, int16_t len, 
+    uint8_t* frame, int16_t* sets, int maxSets)
+{
+    int count;
+    int16_t pos;
+    int16_t lane;
+    uint32_t bits;
+    count = 0;
+    for(pos = start; (pos < start + len) && (count < maxSets); 
+        pos += HARPI_EVENTS_LANES)
+    {
+        bits = matchBlock(table, pos, frame);
+        if( (start + len - pos) < HARPI_EVENTS_LANES )
+        {
+            // Last block: positions out of the range are not checked
+            bits &= (1U << (start + len - pos)) - 1;
+        }
+        for(lane = 0; (bits != 0) && (count < maxSets); lane++)
+        {
+            if(bits & (1U << lane))
+            {
+                sets[count++] = table->planes.set[pos + lane];
+                bits &= ~(1U << lane);
+            }
+        }
+    }
+    return count;
+}
+
+/* Get the published table for reading (lock-free). The table stays valid 
+ * until tableRelease is called with the returned epoch.
+ */
+static harpiEventTable_t* tableAcquire(unsigned int* epoch)
+{
+    *epoch = atomic_load(&g_eventEpoch) & 1;
+    atomic_fetch_add(&g_eventReaders[*epoch], 1);
+    return atomic_load(&g_eventTable);
+}
+
+// Release the table got with tableAcquire
+static void tableRelease(unsigned int epoch)
+{
+    atomic_fetch_sub_explicit(&g_eventReaders[epoch], 1, memory_order_release);
+}
+
+/* Publish a new table (NULL: no event sets) and free the replaced one once
+ * no reader can use it: the epoch is flipped twice, waiting each time for 
+ * the readers of the previous epoch (under g_EventSets_mutex - one writer)
+ */
+static void tablePublish(harpiEventTable_t* table)
+{
+    int i;
+    unsigned int epoch;
+    harpiEventTable_t* old;
+    old = atomic_exchange(&g_eventTable, table);
+    for(i = 0; i < 2; i++)
+    {
+        epoch = atomic_fetch_xor(&g_eventEpoch, 1) & 1;
+        while(atomic_load(&g_eventReaders[epoch]) != 0)
+        {
+            usleep(HARPI_EVENTS_RECLAIM_WAIT);
+        }
+    }
+    freeTable(old);
+}
+
+#ifdef DEBUG_HARPIEVENTS_BENCHMARK
+// Check for a match between event set data and a given frame (byte array)
+static bool isMatch(harpiEventSetsData* set, uint8_t* frame)
+{
+    int16_t i;
+    //-----------------------------------------
+    // Check the frame against the event frame
+    //-----------------------------------------
+    for(i = 0; i < HAPCAN_FULL_FRAME_LEN; i++)
+    {
+        if(!isByteMatch(set->fiterCondition[i], set->fiter[i], frame[i]))
+        {
+            // Leave as soon as a mismatch is detected
+            return false;
+        }
     }
     // Return
-    return match;
+    return true;
+}
+
+// Linear matcher (one set at a time) - benchmark reference
+static int linearMatchCAN(harpiEventTable_t* table, hapcanCANData* hapcanData)
+{
+    int count;
+    int16_t i;
+    uint8_t frame[HAPCAN_FULL_FRAME_LEN];
+    count = 0;
+    for(i = 0; i < table->setsLen; i++)
+    {
+        // LOCK
+        pthread_mutex_lock(&g_EventSets_mutex);
+        // Get byte array from HAPCAN Frame
+        aux_getBytesFromHAPCAN(hapcanData, frame);
+        // Compare Frames
+        if(isMatch(&(table->sets[i]), frame))
+        {
+            count++;
+        }
+        // UNLOCK
+        pthread_mutex_unlock(&g_EventSets_mutex);
+    }
+    return count;
+}
+
+// Random event set: mostly buttons / relays of a small installation
+static void benchmarkSet(harpiEventSetsData* set)
+{
+    int16_t i;
+    int kind;
+    static const uint8_t conditions[] = {'x', 'x', 'x', 'e', 'n', '<', '>'};
+    memset(set, 0, sizeof(harpiEventSetsData));
+    set->eventSetID = rand();
+    kind = rand() % 10;
+    for(i = 0; i < HAPCAN_FULL_FRAME_LEN; i++)
+    {
+        set->fiterCondition[i] = conditions[rand() % sizeof(conditions)];
+        set->fiter[i] = (uint8_t)rand();
+    }
+    // Header: 0x301 / 0x302 frames from modules 1..32, groups 1..8
+    set->fiter[0] = 0x30;
+    set->fiter[1] = (uint8_t)((1 + (rand() % 2)) << 4);
+    set->fiter[2] = (uint8_t)(1 + (rand() % 32));
+    set->fiter[3] = (uint8_t)(1 + (rand() % 8));
+    if(kind < 8)
+    {
+        // Module and group pinned
+        memset(set->fiterCondition, 'e', 4);
+    }
+    else if(kind < 9)
+    {
+        // Frametype pinned
+        memset(set->fiterCondition, 'e', 2);
+    }
+}
+
+// Random frame: built from a random set header (or any frame)
+static void benchmarkFrame(harpiEventTable_t* table, 
+    hapcanCANData* hapcanData)
+{
+    int16_t i;
+    harpiEventSetsData* set;
+    set = &table->sets[rand() % table->setsLen];
+    hapcanData->frametype = (uint16_t)((set->fiter[0] << 4) | 
+        (set->fiter[1] >> 4));
+    hapcanData->flags = 0;
+    hapcanData->module = set->fiter[2];
+    hapcanData->group = set->fiter[3];
+    if(rand() % 4 == 0)
+    {
+        hapcanData->frametype = (uint16_t)(rand() & 0xFFF);
+        hapcanData->module = (uint8_t)rand();
+    }
+    for(i = 0; i < HAPCAN_DATA_LEN; i++)
+    {
+        hapcanData->data[i] = (uint8_t)rand();
+    }
+}
+#endif
+
+/* Add events to the queue (in order). When the queue is full the policy is
+ * HARPIEVENTS_QUEUE_OVERFLOW. Returns the number of events added.
+ */
+static int queuePush(harpiEvent_t* events, int count)
+{
+    harpiEventsQueue_t* queue;
+    struct timespec deadline;
+    bool waited;
+    int added;
+    int check;
+    int i;
+    queue = &g_eventsQueue;
+    waited = false;
+    added = 0;
+    // LOCK
+    pthread_mutex_lock(&g_EventsQueue_mutex);
+    for(i = 0; (queue->events != NULL) && (i < count); i++)
+    {
+        if( (queue->count >= queue->capacity) && 
+            (HARPIEVENTS_QUEUE_OVERFLOW == HARPIEVENTS_OVERFLOW_BLOCK) )
+        {
+            // Wait for the consumer (up to HARPIEVENTS_QUEUE_BLOCK_MS a call)
+            if(!waited)
+            {
+                waited = true;
+                queue->stats.blocked++;
+                clock_gettime(CLOCK_REALTIME, &deadline);
+                deadline.tv_nsec += HARPIEVENTS_QUEUE_BLOCK_MS * 1000000L;
+                deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+                deadline.tv_nsec = deadline.tv_nsec % 1000000000L;
+            }
+            check = 0;
+            while( (queue->count >= queue->capacity) && (check == 0) )
+            {
+                check = pthread_cond_timedwait(&g_EventsQueue_cond, 
+                    &g_EventsQueue_mutex, &deadline);
+            }
+        }
+        if(queue->count >= queue->capacity)
+        {
+            if(HARPIEVENTS_QUEUE_OVERFLOW == HARPIEVENTS_OVERFLOW_DROP_OLDEST)
+            {
+                // Replace the oldest event
+                queue->head = (queue->head + 1) % queue->capacity;
+                queue->count--;
+                queue->stats.droppedOldest++;
+            }
+            else
+            {
+                // Discard the new event
+                queue->stats.droppedNewest++;
+                continue;
+            }
+        }
+        queue->events[(queue->head + queue->count) % queue->capacity] = 
+            events[i];
+        queue->count++;
+        queue->stats.pushed++;
+        if(queue->count > queue->stats.highWaterMark)
+        {
+            queue->stats.highWaterMark = queue->count;
+        }
+        added++;
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_EventsQueue_mutex);
+    #ifdef DEBUG_HARPIEVENTS_ERRORS
+    if(added < count)
+    {
+        debug_print("harpievents - Events queue full: %d dropped!\n", 
+            count - added);
+    }
+    #endif
+    return added;
+}
+
+/* Get up to maxEvents from the queue (oldest first). Returns the number of 
+ * events.
+ */
+static int queuePop(harpiEvent_t* events, int maxEvents)
+{
+    harpiEventsQueue_t* queue;
+    int count;
+    int i;
+    queue = &g_eventsQueue;
+    // LOCK
+    pthread_mutex_lock(&g_EventsQueue_mutex);
+    count = (int)queue->count;
+    if(count > maxEvents)
+    {
+        count = maxEvents;
+    }
+    for(i = 0; i < count; i++)
+    {
+        events[i] = queue->events[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+    }
+    queue->count -= count;
+    if(count > 0)
+    {
+        // Room available
+        pthread_cond_broadcast(&g_EventsQueue_cond);
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_EventsQueue_mutex);
+    return count;
 }
 
 //----------------------------------------------------------------------------//
@@ -153,185 +913,362 @@ static bool isMatch(harpiEventSetsData* set, hapcanCANData* hapcanData)
 //----------------------------------------------------------------------------//
 int harpievents_createBuffer(void)
 {
-    int check;
+    harpiEventsQueue_t* queue;
+    queue = &g_eventsQueue;
     // LOCK 
-    pthread_mutex_lock(&g_EventSets_mutex);
-    // Init Buffer
-    if(harpiEventsBufferID < 0)
+    pthread_mutex_lock(&g_EventsQueue_mutex);
+    // Init Buffer (all the events allocated here)
+    if(queue->events == NULL)
     {
-        harpiEventsBufferID = buffer_init(HARPI_EVENTS_BUFFER_SIZE);
+        queue->events = (harpiEvent_t*)malloc(HARPIEVENTS_QUEUE_SIZE * 
+            sizeof(harpiEvent_t));
+        queue->capacity = HARPIEVENTS_QUEUE_SIZE;
+        queue->head = 0;
+        queue->count = 0;
+        memset(&queue->stats, 0, sizeof(harpiEventsStats_t));
     }
     // UNLOCK
-    pthread_mutex_unlock(&g_EventSets_mutex);
-    // Check buffer - should have ID
-    check = 0;
-    if(harpiEventsBufferID < 0)
+    pthread_mutex_unlock(&g_EventsQueue_mutex);
+    // Check buffer
+    if(queue->events == NULL)
     {
         #ifdef DEBUG_HARPIEVENTS_ERRORS
         debug_print("harpievents_createBuffer ERROR - Buffer Error!\n");
-        debug_print("- Buffer: %d\n", harpiEventsBufferID);
         #endif
-        check = 1;
-    }
-    if(check > 0)
-    {
         // return error
         return EXIT_FAILURE;
     }
-    else
+    // return OK
+    return EXIT_SUCCESS;
+}
+
+int harpievents_enableEvents(void)
+{
+    // LOCK 
+    pthread_mutex_lock(&g_EventSets_mutex);
+    if(harpiEventsFD < 0)
     {
-        // return OK
-        return EXIT_SUCCESS;
+        harpiEventsFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
     }
+    // UNLOCK
+    pthread_mutex_unlock(&g_EventSets_mutex);
+    #ifdef DEBUG_HARPIEVENTS_ERRORS
+    if(harpiEventsFD < 0)
+    {
+        debug_print("harpievents_enableEvents ERROR - eventfd!\n");
+    }
+    #endif
+    return harpiEventsFD;
 }
 
 void harpievents_init(void)
 {
     //---------------------------------------------
-    // Delete Linked List and Array - PROTECTED
+    // Delete table - PROTECTED
     //---------------------------------------------
     // LOCK
     pthread_mutex_lock(&g_EventSets_mutex);
-    // Init array
-    if(harpiEventSetArray != NULL)
-    {
-        free(harpiEventSetArray);
-        harpiEventSetArray = NULL;
-    }
-    harpiEventSetArrayLen = 0;
-    // Clean buffer
-    buffer_clean(harpiEventsBufferID);
+    // No event sets (replaced table freed when its readers are done)
+    tablePublish(NULL);
     // UNLOCK
     pthread_mutex_unlock(&g_EventSets_mutex);
+    // Clean buffer
+    // LOCK
+    pthread_mutex_lock(&g_EventsQueue_mutex);
+    g_eventsQueue.head = 0;
+    g_eventsQueue.count = 0;
+    pthread_cond_broadcast(&g_EventsQueue_cond);
+    // UNLOCK
+    pthread_mutex_unlock(&g_EventsQueue_mutex);
 }
 
 void harpievents_load(harpiLinkedList* element)
 {
     bool isOK;
+    harpiEventTable_t* table;
     //---------------------------------------------
-    // Clear array, copy from list to array, delete linked lisk - PROTECTED
+    // New table from the list (not visible to the readers yet)
     //---------------------------------------------
-    // LOCK
-    pthread_mutex_lock(&g_EventSets_mutex);
-    // Clear array
-    if(harpiEventSetArray != NULL)
+    table = (harpiEventTable_t*)calloc(1, sizeof(harpiEventTable_t));
+    isOK = (table != NULL);
+    if(isOK)
     {
-        free(harpiEventSetArray);
-        harpiEventSetArray = NULL;
+        // Get array size and allocate memory
+        table->setsLen = harpi_getLinkedListNElements(
+            CSV_SECTION_EVENT_SETS);
+        table->sets = (harpiEventSetsData*)malloc((table->setsLen + 1) * 
+            sizeof(harpiEventSetsData));
+        isOK = (table->sets != NULL);
     }
-    // Get array size and allocate memory
-    harpiEventSetArrayLen = harpi_getLinkedListNElements(
-        CSV_SECTION_EVENT_SETS);
-    harpiEventSetArray = (harpiEventSetsData*)malloc(harpiEventSetArrayLen * 
-        sizeof(harpiEventSetsData));
     // Create array from list
-    isOK = copyListToArray(element);
-    // UNLOCK
-    pthread_mutex_unlock(&g_EventSets_mutex);
+    isOK = isOK && copyListToArray(table, element);
+    // Create index from array
+    isOK = isOK && buildIndex(table);
     // Clear data if copy had an error
     if(!isOK)
     {
+        freeTable(table);
         harpievents_init();
+        return;
     }
+    //---------------------------------------------
+    // Publish the table - PROTECTED
+    //---------------------------------------------
+    // LOCK
+    pthread_mutex_lock(&g_EventSets_mutex);
+    tablePublish(table);
+    // UNLOCK
+    pthread_mutex_unlock(&g_EventSets_mutex);
 }
 
-void harpievents_handleCAN(hapcanCANData* hapcanData, 
-    unsigned long long timestamp)
+int harpievents_matchCAN(hapcanCANData* hapcanData, harpiEvent_t* events, 
+    int maxEvents)
 {
-    int16_t i;
-    int check;
-    bool match;
-    harpiEvent_t event;
-    // Check for a match
-    for(i = 0; i < harpiEventSetArrayLen; i++)
+    int count;
+    int16_t frametype;
+    int16_t set;
+    int16_t start;
+    int16_t pos[HARPI_EVENT_KEY_NONE + 1];
+    int16_t len[HARPI_EVENT_KEY_NONE + 1];
+    int16_t matched[HARPI_EVENT_KEY_NONE + 1][HARPIEVENTS_MAX_MATCH + 1];
+    harpiEventKeyType_t type;
+    harpiEventKeyType_t next;
+    uint32_t key;
+    uint8_t frame[HAPCAN_FULL_FRAME_LEN];
+    unsigned int epoch;
+    harpiEventTable_t* table;
+    // Init
+    count = 0;
+    if(maxEvents > HARPIEVENTS_MAX_MATCH)
     {
-        match = false;
-        // LOCK
-        pthread_mutex_lock(&g_EventSets_mutex);
-        // Compare Frames
-        match = isMatch(&(harpiEventSetArray[i]), hapcanData);
-        // UNLOCK
-        pthread_mutex_unlock(&g_EventSets_mutex);
-        // Check compared frames
-        if(match)
-        {
-            event.eventSetID = harpiEventSetArray[i].eventSetID;
-            event.type = HARPI_EVENT_CAN;
-            // Match - Add a new event to the buffer
-            check = buffer_push(harpiEventsBufferID, &event, sizeof(event));
-            if( check != BUFFER_OK )
+        maxEvents = HARPIEVENTS_MAX_MATCH;
+    }
+    frametype = hapcanData->frametype & (HARPI_EVENTS_FRAMETYPES - 1);
+    // Current table (lock-free - consistent until released)
+    table = tableAcquire(&epoch);
+    // Fast rejection: no event set for this frametype
+    if( (table == NULL) || ( (table->frametypeBitmap[frametype >> 3] & 
+        (1 << (frametype & 0x07))) == 0 ) )
+    {
+        tableRelease(epoch);
+        return 0;
+    }
+    // Get byte array from HAPCAN Frame (once for all sets)
+    aux_getBytesFromHAPCAN(hapcanData, frame);
+    //-----------------------------------------
+    // Match index buckets and not indexed sets (one extra to detect overflow)
+    //-----------------------------------------
+    key = ((uint32_t)frame[0] << 24) | ((uint32_t)frame[1] << 16) | 
+        ((uint32_t)frame[2] << 8) | (uint32_t)frame[3];
+    start = lookupIndex(&table->index[HARPI_EVENT_KEY_HEADER], key, 
+        &len[HARPI_EVENT_KEY_HEADER]);
+    len[HARPI_EVENT_KEY_HEADER] = matchRange(table, start, 
+        len[HARPI_EVENT_KEY_HEADER], frame, matched[HARPI_EVENT_KEY_HEADER], 
+        maxEvents + 1);
+    key = ((uint32_t)frame[0] << 8) | (uint32_t)frame[1];
+    start = lookupIndex(&table->index[HARPI_EVENT_KEY_FRAMETYPE], key, 
+        &len[HARPI_EVENT_KEY_FRAMETYPE]);
+    len[HARPI_EVENT_KEY_FRAMETYPE] = matchRange(table, start, 
+        len[HARPI_EVENT_KEY_FRAMETYPE], frame, 
+        matched[HARPI_EVENT_KEY_FRAMETYPE], maxEvents + 1);
+    len[HARPI_EVENT_KEY_NONE] = matchRange(table, table->otherStart, 
+        table->otherLen, frame, matched[HARPI_EVENT_KEY_NONE], maxEvents + 1);
+    memset(pos, 0, sizeof(pos));
+    //-----------------------------------------
+    // Events in configuration order (merge of sorted lists)
+    //-----------------------------------------
+    while(1)
+    {
+        next = HARPI_EVENT_KEY_NONE + 1;
+        for(type = HARPI_EVENT_KEY_HEADER; type <= HARPI_EVENT_KEY_NONE; type++)
+        {
+            if( (pos[type] < len[type]) && ( (next > HARPI_EVENT_KEY_NONE) || 
+                (matched[type][pos[type]] < matched[next][pos[next]]) ) )
             {
-                //----------------
-                // FATAL ERROR
-                //----------------
-                #ifdef DEBUG_HARPIEVENTS_ERRORS
-                debug_print("harpievents_handleCAN - Buffer Error!\n");
-                debug_print("- Buffer Index: %d\n", harpiEventsBufferID);
-                #endif
+                next = type;
             }
         }
+        if(next > HARPI_EVENT_KEY_NONE)
+        {
+            // No more matches
+            break;
+        }
+        set = matched[next][pos[next]];
+        pos[next]++;
+        if(count >= maxEvents)
+        {
+            //----------------
+            // FATAL ERROR
+            //----------------
+            #ifdef DEBUG_HARPIEVENTS_ERRORS
+            debug_print("harpievents_matchCAN - Too many events!\n");
+            debug_print("- Maximum: %d\n", maxEvents);
+            #endif
+            break;
+        }
+        events[count].eventSetID = table->sets[set].eventSetID;
+        events[count].type = HARPI_EVENT_CAN;
+        count++;
     }
+    tableRelease(epoch);
+    // Return
+    return count;
 }
 
-int harpievents_getEvent(harpiEvent_t* event)
+void harpievents_handleCAN(hapcanCANData* hapcanData, 
+    unsigned long long timestamp)
 {
-    int ret;
     int count;
-    int check;
-    unsigned int data_size;
-    // Init
-    ret = HARPIEVENTS_ERROR;
-    // LOCK 
-    pthread_mutex_lock(&g_EventSets_mutex);
-    //-------------------------------------------
-    // Get the number of elements in the buffer
-    //-------------------------------------------
-    count = buffer_dataCount(harpiEventsBufferID);
+    uint64_t one;
+    harpiEvent_t events[HARPIEVENTS_MAX_MATCH];
+    // Check for a match
+    count = harpievents_matchCAN(hapcanData, events, HARPIEVENTS_MAX_MATCH);
     if(count <= 0)
     {
-        // No event in buffer - Unlock buffers and return now
-        ret = HARPIEVENTS_NO_EVENT;
-        // UNLOCK 
-        pthread_mutex_unlock(&g_EventSets_mutex);
-        return ret;
+        return;
     }
-    //-------------------------------------------
-    // Get the data size
-    //-------------------------------------------
-    data_size = buffer_popSize(harpiEventsBufferID);
-    if(data_size == sizeof(harpiEvent_t))
+    // Match - Add the new events to the buffer
+    count = queuePush(events, count);
+    // Wake up the events consumer (one signal per frame)
+    if( (count > 0) && (harpiEventsFD >= 0) )
     {
-        //-------------------------------------------
-        // Read from buffer - Fill event
-        //-------------------------------------------
-        check = buffer_pop(harpiEventsBufferID, event, sizeof(harpiEvent_t));
-        if(check != BUFFER_OK)
+        one = 1;
+        if(write(harpiEventsFD, &one, sizeof(one)) < 0)
         {
-            //---------------
-            // FATAL ERROR
-            //---------------
             #ifdef DEBUG_HARPIEVENTS_ERRORS
-            debug_print("harpievents_getEvent: Buffer ERROR - data pop!\n");
+            debug_print("harpievents_handleCAN - eventfd Error!\n");
             #endif
-            ret = HARPIEVENTS_ERROR;
-        }
-        else
-        {
-            ret = HARPIEVENTS_NEW_EVENT;
         }
     }
-    else
+}
+
+int harpievents_getEvent(harpiEvent_t* event)
+{
+    return harpievents_getEvents(event, 1) > 0 ? HARPIEVENTS_NEW_EVENT : 
+        HARPIEVENTS_NO_EVENT;
+}
+
+int harpievents_getEvents(harpiEvent_t* events, int maxEvents)
+{
+    if(g_eventsQueue.events == NULL)
     {
         //---------------
         // FATAL ERROR
         //---------------
         #ifdef DEBUG_HARPIEVENTS_ERRORS
-        debug_print("harpievents_getEvent: Buffer ERROR - Data Size is 0!\n");
+        debug_print("harpievents_getEvents: Buffer ERROR - no buffer!\n");
         #endif
-        ret = HARPIEVENTS_ERROR;
+        return HARPIEVENTS_ERROR;
     }
-    // UNLOCK 
-    pthread_mutex_unlock(&g_EventSets_mutex);
-    // return
-    return ret;
-}
\ No newline at end of file
+    return queuePop(events, maxEvents);
+}
+
+void harpievents_getStats(harpiEventsStats_t* stats, bool reset)
+{
+    // LOCK
+    pthread_mutex_lock(&g_EventsQueue_mutex);
+    *stats = g_eventsQueue.stats;
+    stats->capacity = g_eventsQueue.capacity;
+    stats->count = g_eventsQueue.count;
+    if(reset)
+    {
+        memset(&g_eventsQueue.stats, 0, sizeof(harpiEventsStats_t));
+        g_eventsQueue.stats.highWaterMark = g_eventsQueue.count;
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_EventsQueue_mutex);
+}
+
+#ifdef DEBUG_HARPIEVENTS_BENCHMARK
+void harpievents_benchmark(void)
+{
+    int i;
+    int f;
+    int counts[3];
+    double ns[3];
+    unsigned long long t0;
+    unsigned long long t1;
+    int16_t sets[HARPIEVENTS_MAX_MATCH + 1];
+    uint8_t frame[HAPCAN_FULL_FRAME_LEN];
+    harpiEvent_t events[HARPIEVENTS_MAX_MATCH];
+    hapcanCANData* frames;
+    harpiEventTable_t* table;
+    static const int16_t sizes[] = {100, 1000, 10000};
+    frames = malloc(HARPI_EVENTS_BENCHMARK_FRAMES * sizeof(hapcanCANData));
+    if(frames == NULL)
+    {
+        return;
+    }
+    srand(1);
+    for(i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        //-----------------------------------------
+        // Random event sets and frames
+        //-----------------------------------------
+        table = (harpiEventTable_t*)calloc(1, sizeof(harpiEventTable_t));
+        if(table == NULL)
+        {
+            break;
+        }
+        table->setsLen = sizes[i];
+        table->sets = (harpiEventSetsData*)malloc(table->setsLen *
+            sizeof(harpiEventSetsData));
+        if(table->sets == NULL)
+        {
+            freeTable(table);
+            break;
+        }
+        for(f = 0; f < table->setsLen; f++)
+        {
+            benchmarkSet(&table->sets[f]);
+        }
+        if(!buildIndex(table))
+        {
+            freeTable(table);
+            break;
+        }
+        for(f = 0; f < HARPI_EVENTS_BENCHMARK_FRAMES; f++)
+        {
+            benchmarkFrame(table, &frames[f]);
+        }
+        // LOCK
+        pthread_mutex_lock(&g_EventSets_mutex);
+        tablePublish(table);
+        // UNLOCK
+        pthread_mutex_unlock(&g_EventSets_mutex);
+        //-----------------------------------------
+        // Linear, linear (planes, all sets) and indexed (planes)
+        //-----------------------------------------
+        memset(counts, 0, sizeof(counts));
+        t0 = aux_getnsSinceEpoch();
+        for(f = 0; f < HARPI_EVENTS_BENCHMARK_FRAMES; f++)
+        {
+            counts[0] += linearMatchCAN(table, &frames[f]);
+        }
+        t1 = aux_getnsSinceEpoch();
+        ns[0] = (double)(t1 - t0) / HARPI_EVENTS_BENCHMARK_FRAMES;
+        t0 = aux_getnsSinceEpoch();
+        for(f = 0; f < HARPI_EVENTS_BENCHMARK_FRAMES; f++)
+        {
+            aux_getBytesFromHAPCAN(&frames[f], frame);
+            counts[1] += matchRange(table, 0, table->planes.len, frame, sets, 
+                HARPIEVENTS_MAX_MATCH + 1);
+        }
+        t1 = aux_getnsSinceEpoch();
+        ns[1] = (double)(t1 - t0) / HARPI_EVENTS_BENCHMARK_FRAMES;
+        t0 = aux_getnsSinceEpoch();
+        for(f = 0; f < HARPI_EVENTS_BENCHMARK_FRAMES; f++)
+        {
+            counts[2] += harpievents_matchCAN(&frames[f], events, 
+                HARPIEVENTS_MAX_MATCH);
+        }
+        t1 = aux_getnsSinceEpoch();
+        ns[2] = (double)(t1 - t0) / HARPI_EVENTS_BENCHMARK_FRAMES;
+        debug_print("harpievents_benchmark: %5d sets - ns/frame: linear %.0f, "
+            "vector %.0f, indexed %.0f - matches: %d / %d / %d\n", sizes[i], 
+            ns[0], ns[1], ns[2], counts[0], counts[1], counts[2]);
+    }
+    free(frames);
+    harpievents_init();
+}
+#endif
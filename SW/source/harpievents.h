@@ -6,6 +6,24 @@
 //  1.00     | 01/Jun/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - harpievents_enableEvents: eventfd signalled on new events                //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - harpievents_matchCAN: matched events returned for immediate dispatch     //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - harpievents_benchmark: event set matchers compared                       //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - harpievents_getEvents: pending events drained at once                    //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - Typed events queue: overflow policy and statistics                       //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - Events queue: only used with HARPI_IMMEDIATE_DISPATCH undefined          //
+//----------------------------------------------------------------------------//
 
 #ifndef HARPIEVENTS_H
 #define HARPIEVENTS_H
@@ -24,23 +42,64 @@ extern "C" {
 #define HARPIEVENTS_NEW_EVENT   1
 #define HARPIEVENTS_NO_EVENT    0
 #define HARPIEVENTS_ERROR       -1
+// Maximum number of events generated by a single CAN frame
+#define HARPIEVENTS_MAX_MATCH   60
+/* Events queue: capacity (preallocated) and overflow policy, set when 
+ * building (no runtime setting). The queue is only used with 
+ * HARPI_IMMEDIATE_DISPATCH undefined (see harpi.h): with immediate dispatch 
+ * the events never reach it and its statistics stay at zero.
+ */
+#define HARPIEVENTS_QUEUE_SIZE      256
+#define HARPIEVENTS_QUEUE_OVERFLOW  HARPIEVENTS_OVERFLOW_DROP_OLDEST
+// Maximum time a producer waits for room (HARPIEVENTS_OVERFLOW_BLOCK) - ms
+#define HARPIEVENTS_QUEUE_BLOCK_MS  5
     
 //----------------------------------------------------------------------------//
 // EXTERNAL TYPES
 //----------------------------------------------------------------------------//
+// Events queue overflow policy
+typedef enum
+{
+    HARPIEVENTS_OVERFLOW_DROP_OLDEST = 0,   // Oldest event replaced
+    HARPIEVENTS_OVERFLOW_DROP_NEWEST,       // New event discarded
+    HARPIEVENTS_OVERFLOW_BLOCK              // Producer waits for room (up to
+                                            // HARPIEVENTS_QUEUE_BLOCK_MS), 
+                                            // then new event discarded
+} harpiEventsOverflow_t;
 
+// Events queue statistics
+typedef struct
+{
+    unsigned int capacity;
+    unsigned int count;                 // Events in the queue
+    unsigned int highWaterMark;         // Maximum events in the queue
+    unsigned long long pushed;          // Events added
+    unsigned long long droppedOldest;   // Events replaced (queue full)
+    unsigned long long droppedNewest;   // Events discarded (queue full)
+    unsigned long long blocked;         // Producer waits (queue full)
+} harpiEventsStats_t;
     
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
 /**
- * Init events buffer (to be called once)
+ * Init events buffer (to be called once): HARPIEVENTS_QUEUE_SIZE events 
+ * preallocated, HARPIEVENTS_QUEUE_OVERFLOW when full
  * 
  * \return  EXIT_SUCCESS
  *          EXIT_FAILURE (Close and Reinit Buffers)
  **/
 int harpievents_createBuffer(void);
 
+/**
+ * Enable the new event notifications: the returned eventfd is signalled 
+ * every time events are added to the buffer (to be used with poll / epoll by
+ * the thread calling harpievents_getEvent).
+ * 
+ * \return  eventfd (non-blocking) / -1 on error
+ **/
+int harpievents_enableEvents(void);
+
 /**
  * Init data:
  * - empty the list and if list is available, free used memory
@@ -56,9 +115,23 @@ void harpievents_init(void);
 void harpievents_load(harpiLinkedList* element);
 
 /**
- * Check the CAN message received for generating events
+ * Check the CAN message received and return the events generated (the events
+ * are NOT added to the buffer - immediate dispatch).
+ * \param   hapcanData      (INPUT) received HAPCAN Frame
+ *          events          (OUTPUT) events generated
+ *          maxEvents       (INPUT) size of "events" (up to 
+ *                          HARPIEVENTS_MAX_MATCH)
+ * 
+ * \return  number of events generated
+ */
+int harpievents_matchCAN(hapcanCANData* hapcanData, harpiEvent_t* events, 
+        int maxEvents);
+
+/**
+ * Check the CAN message received for generating events (added to the buffer)
  * \param   hapcanData      (INPUT) received HAPCAN Frame
- *          timestamp       (INPUT) Received message timestamp
+ *          timestamp       (INPUT) Received message timestamp (ns since
+ *                          epoch - kernel receive time)
  * 
  */
 void harpievents_handleCAN(hapcanCANData* hapcanData, 
@@ -75,6 +148,37 @@ void harpievents_handleCAN(hapcanCANData* hapcanData,
  */
 int harpievents_getEvent(harpiEvent_t* event);
 
+/**
+ * Get all the pending events from the buffer (in order) with a single lock.
+ * 
+ * \param   events      (OUTPUT) Events to be filled
+ *          maxEvents   (INPUT) size of "events"
+ * 
+ * \return      number of events filled (0: no new event) |
+ *              HARPIEVENTS_ERROR           error (no event filled)
+ */
+int harpievents_getEvents(harpiEvent_t* events, int maxEvents);
+
+/**
+ * Get the events buffer statistics (all zero with HARPI_IMMEDIATE_DISPATCH,
+ * the events are not queued)
+ * 
+ * \param   stats   (OUTPUT) statistics
+ *          reset   (INPUT) true to restart the counters (high water mark set 
+ *                  to the current number of events)
+ */
+void harpievents_getStats(harpiEventsStats_t* stats, bool reset);
+
+/**
+ * Benchmark of the event set matchers (DEBUG_HARPIEVENTS_BENCHMARK): random
+ * event sets (100, 1000 and 10000) are matched against random frames by the
+ * linear matcher (one set at a time), the vector matcher over all the sets
+ * and the indexed vector matcher. Results are printed (debug_print).
+ * The loaded event sets are cleared - to be called before loading the
+ * configuration.
+ */
+void harpievents_benchmark(void);
+
 #ifdef __cplusplus
 }
 #endif
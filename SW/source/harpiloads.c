@@ -6,6 +6,33 @@
 //  1.00     | 01/Jun/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - State machines indexed by the (dense) stateMachineID                     //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Frames to be sent kept per call (called by the state machine shards)     //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - harpiloads_getLoadsOFF: frames sent later by the caller                  //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - Loads indexed by (frametype, node, group, channel); SM counters          //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - Load status discovery by node/group with a window of requests            //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - Load status refresh: stalest nodes first, frames/s budget                //
+//----------------------------------------------------------------------------//
+//  1.07     | 16/Oct/2026 |                               | ALCP             //
+// - Loads OFF on the control lane, status requests on the background         //
+//----------------------------------------------------------------------------//
+//  1.08     | 16/Oct/2026 |                               | ALCP             //
+// - Loads OFF frames encoded (struct can_frame) when loading                 //
+//----------------------------------------------------------------------------//
+//  1.09     | 16/Oct/2026 |                               | ALCP             //
+// - harpiloads_setLoadsOFF removed (loads OFF sent by harpism)               //
+//----------------------------------------------------------------------------//
 
 /*
 * Includes
@@ -16,6 +43,7 @@
 #include <unistd.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <time.h>
 #include <pthread.h>
 #include <auxiliary.h>
 #include <debug.h>
@@ -26,9 +54,7 @@
 //----------------------------------------------------------------------------//
 #define CHANNEL_BYTE        2
 #define STATUS_BYTE         3
-#define INITIAL_DELAY       10 // 5 seconds (see HARPILOADS_PERIOD)
-#define WAIT_DELAY_NORMAL   1  // 500ms (see HARPILOADS_PERIOD)
-#define WAIT_DELAY_ERROR    60 // 30 seconds (see HARPILOADS_PERIOD)
+#define DISCOVERY_NONE      -1  // Node without request in flight
 
 //----------------------------------------------------------------------------//
 // INTERNAL TYPES
@@ -45,24 +71,70 @@ typedef struct
 {
     harpiSMLoadsData load;
     harpiLoadStatus_t status;
+    int16_t node;       // nodesArray index
+    uint64_t confirmed; // ms - last status frame
 } hlLoads_t;
 
-// State of each state machine
+// State of each state machine (smStatusArray index: stateMachineID)
 typedef struct  
 {
-    int16_t stateMachineID;
     harpiLoadStatus_t status;
+    int16_t offStart;   // OFF frames: offFrameArray[offStart..+offCount-1]
+    int16_t offCount;
+    int16_t loads;      // Loads of the state machine
+    int16_t loadsON;
+    int16_t loadsUndefined;
 } hlSM_t;
 
-// Periodic actions control
+// Loads with the same key: loadsByKey[start..start+count-1]
+// (see getLoadKey - count 0: empty bucket)
+typedef struct
+{
+    uint64_t key;
+    int16_t start;
+    int16_t count;
+} hlBucket_t;
+
+// Load to be indexed (sorted by key)
+typedef struct
+{
+    uint64_t key;
+    int16_t load;
+} hlKey_t;
+
+// Node (node, group) with loads - status requested while any load is 
+// undefined
+typedef struct  
+{
+    uint8_t node;
+    uint8_t group;
+    int16_t undefined;  // Loads with undefined status
+    int16_t request;    // Request in flight (DISCOVERY_NONE if none)
+    int16_t retries;
+    uint64_t notBefore; // ms - backoff
+    uint64_t refreshed; // ms - last refresh request
+    uint64_t oldest;    // ms - stalest load (see addRefresh)
+    bool active;        // Any load of an active state machine
+} hlNode_t;
+
+// Request in flight
+typedef struct  
+{
+    int16_t pending;    // Nodes still undefined (0: free)
+    uint64_t deadline;  // ms
+} hlRequest_t;
+
+// Load status discovery (periodic actions control)
 typedef struct  
 {
-    int16_t initial_delay;
-    int16_t current_delay;
-    int16_t wait;
-    uint8_t last_node;
-    uint8_t last_group;
-} hlPeriodic_t;
+    uint64_t start;     // ms - load
+    uint64_t done;      // ms - all loads defined (0: not yet)
+    int16_t undefined;  // Nodes with undefined loads
+    hlRequest_t requests[HARPILOADS_DISCOVERY_WINDOW];
+    uint64_t refreshTime;   // ms - last refresh budget update
+    uint64_t refreshCredit; // Budget (1000 per status request)
+    harpiLoadsDiscoveryStats_t stats;
+} hlDiscovery_t;
 
 //----------------------------------------------------------------------------//
 // INTERNAL GLOBAL VARIABLES
@@ -74,10 +146,17 @@ static hlLoads_t* loadsStatusArray = NULL;
 static int16_t loadsStatusArrayLen = 0;
 static hlSM_t* smStatusArray = NULL;
 static int16_t smStatusArrayLen = 0;
-static hlPeriodic_t periodInfo;
+static hlNode_t* nodesArray = NULL;
+static int16_t nodesArrayLen = 0;
+static hlDiscovery_t discovery;
 static hlFrameInfo_t* offFrameArray;
 static int16_t offFrameArrayLen = 0;
-static hapcanCANData frames[MAXIMUM_ACTIONS];
+// OFF frames (grouped by state machine) encoded for the CAN socket
+static struct can_frame* offCANFrames = NULL;
+// Loads index: key -> loadsStatusArray indexes
+static int16_t* loadsByKey = NULL;
+static hlBucket_t* loadsBuckets = NULL;
+static uint32_t loadsBucketsMask = 0;
 
 //----------------------------------------------------------------------------//
 // INTERNAL FUNCTIONS
@@ -88,6 +167,24 @@ static void initStateMachinesArray(void);
 static void initOffFramesArray(void);
 static void updateRelayOffFrame(harpiSMLoadsData* load);
 static void getLoadOffInfo(harpiSMLoadsData* load, hlFrameInfo_t* frame_info);
+static uint64_t getLoadKey(uint16_t frametype, uint8_t node, uint8_t group, 
+    uint8_t channel);
+static uint16_t getLoadFrameType(harpiLoadType_t type);
+static uint32_t hashKey(uint64_t key);
+static int compareKeys(const void* a, const void* b);
+static void freeLoadsIndex(void);
+static void initLoadsIndex(void);
+static int16_t lookupLoads(uint64_t key, int16_t* count);
+static void updateSMStatus(hlSM_t* sm);
+static void setLoadStatus(int16_t i_Load, harpiLoadStatus_t status);
+static uint64_t getms(void);
+static void initDiscovery(void);
+static void setNodeDefined(hlNode_t* node);
+static void checkRequests(uint64_t now);
+static int16_t getFreeRequest(void);
+static int16_t addRequests(uint64_t now, hapcanCANData* frames, 
+    int16_t maxFrames);
+static int16_t addRefresh(uint64_t now, bool idle, hapcanCANData* frame);
 
 // Copy from the Linked List to the Array
 static bool copyListToArray(harpiLinkedList* element)
@@ -148,20 +245,19 @@ static void initLoadsArray(void)
                 sizeof(harpiSMLoadsData));
             // Init each load as undefined state
             loadsStatusArray[i].status = HARPI_LOAD_STATUS_UNDEFINED;
+            loadsStatusArray[i].node = DISCOVERY_NONE;
+            loadsStatusArray[i].confirmed = 0;
         }
     }
 }
 
 // From the State Machine loads array, create the state machine status and 
-// initialize it
+// initialize it (one per stateMachineID - no loads by default)
 static void initStateMachinesArray(void)
 {
     int16_t i_Load;
     int16_t i_SM;
-    int16_t* tempArray = NULL;
-    int16_t tempArrayLen = 0;
-    int16_t smcount;
-    bool ignoreState;
+    int16_t smID;
     // Init array
     if(smStatusArray != NULL)
     {
@@ -169,59 +265,44 @@ static void initStateMachinesArray(void)
         smStatusArray = NULL;
     }
     smStatusArrayLen = 0;
-    // Init counter
-    smcount = 0;
-    // Update if "State Machines and Loads" exists and is OK
-    if(harpiSMLoadsArrayLen > 0)
+    // One status per state machine
+    smStatusArrayLen = harpi_getIDCount(HARPI_ID_STATE_MACHINE);
+    if(smStatusArrayLen > 0)
     {
-        // Init Temp Array
-        tempArray = (int16_t*)malloc(harpiSMLoadsArrayLen * sizeof(int16_t));
-        tempArrayLen = harpiSMLoadsArrayLen;
-        // Init entire array
-        for(i_SM = 0; i_SM < tempArrayLen; i_SM++)
+        smStatusArray = (hlSM_t*)malloc(smStatusArrayLen * sizeof(hlSM_t));
+        for(i_SM = 0; i_SM < smStatusArrayLen; i_SM++)
         {
-            tempArray[i_SM] = -1;
+            smStatusArray[i_SM].status = HARPI_LOAD_STATUS_NO_LOADS;
+            smStatusArray[i_SM].offStart = 0;
+            smStatusArray[i_SM].offCount = 0;
+            smStatusArray[i_SM].loads = 0;
+            smStatusArray[i_SM].loadsON = 0;
+            smStatusArray[i_SM].loadsUndefined = 0;
         }
-        // Init first position
-        tempArray[0] = harpiSMLoadsArray[0].stateMachineID;
-        smcount++;
-        // Check the State Machine loads array
+        // State machines with loads (all undefined)
         for(i_Load = 0; i_Load < harpiSMLoadsArrayLen; i_Load++)
         {
-            ignoreState = false;
-            for(i_SM = 0; i_SM < smcount; i_SM++)
-            {
-                if(harpiSMLoadsArray[i_Load].stateMachineID == tempArray[i_SM])
-                {
-                    ignoreState = true;
-                }
-            }
-            if(!ignoreState)
+            smID = harpiSMLoadsArray[i_Load].stateMachineID;
+            if( (smID >= 0) && (smID < smStatusArrayLen) )
             {
-                // Add to the list of states
-                tempArray[smcount] = harpiSMLoadsArray[i_Load].stateMachineID;
-                smcount++;
+                smStatusArray[smID].loads++;
+                smStatusArray[smID].loadsUndefined++;
+                updateSMStatus(&smStatusArray[smID]);
             }
         }
-        // Copy from temporary array to final array
-        smStatusArrayLen = smcount;
-        smStatusArray = (hlSM_t*)malloc(smStatusArrayLen * sizeof(hlSM_t));
-        for(i_SM = 0; i_SM < smStatusArrayLen; i_SM++)
-        {
-            smStatusArray[i_SM].stateMachineID = tempArray[i_SM];
-            smStatusArray[i_SM].status = HARPI_LOAD_STATUS_UNDEFINED;
-        }
-        // Free temporary array
-        free(tempArray);
-        tempArray = NULL;
     }
 }
 
 // Generate an array with the HAPCAN frames to be sent for each state machine
-// to set its loads to OFF 
+// to set its loads to OFF (grouped by state machine - see hlSM_t)
 static void initOffFramesArray(void)
 {
     int16_t i_load;
+    int16_t i;
+    int16_t smID;
+    int16_t start;
+    int16_t pos;
+    hlFrameInfo_t* sorted;
     // Init array and length
     if(offFrameArray != NULL)
     {
@@ -229,6 +310,11 @@ static void initOffFramesArray(void)
         offFrameArray = NULL;
     }
     offFrameArrayLen = 0;
+    if(offCANFrames != NULL)
+    {
+        free(offCANFrames);
+        offCANFrames = NULL;
+    }
     // Update if "State Machines and Loads" exists and is OK
     if(harpiSMLoadsArrayLen > 0)
     {
@@ -257,7 +343,58 @@ static void initOffFramesArray(void)
                 offFrameArrayLen++;
                 break;
         }
-    }    
+    }
+    //----------------------------------------
+    // Group by state machine (same order inside each group) and encode
+    //----------------------------------------
+    if( (offFrameArrayLen <= 0) || (smStatusArrayLen <= 0) )
+    {
+        return;
+    }
+    sorted = (hlFrameInfo_t*)malloc(offFrameArrayLen * sizeof(hlFrameInfo_t));
+    offCANFrames = (struct can_frame*)malloc(offFrameArrayLen * 
+        sizeof(struct can_frame));
+    if( (sorted == NULL) || (offCANFrames == NULL) )
+    {
+        #ifdef DEBUG_HARPILOADS_ERRORS
+        debug_print("harpiloads_load error - OFF frames memory!\n");
+        #endif
+        free(sorted);
+        free(offCANFrames);
+        offCANFrames = NULL;
+        return;
+    }
+    for(i = 0; i < offFrameArrayLen; i++)
+    {
+        smID = offFrameArray[i].stateMachineID;
+        if( (smID >= 0) && (smID < smStatusArrayLen) )
+        {
+            smStatusArray[smID].offCount++;
+        }
+    }
+    start = 0;
+    for(i = 0; i < smStatusArrayLen; i++)
+    {
+        smStatusArray[i].offStart = start;
+        start += smStatusArray[i].offCount;
+        smStatusArray[i].offCount = 0;
+    }
+    for(i = 0; i < offFrameArrayLen; i++)
+    {
+        smID = offFrameArray[i].stateMachineID;
+        if( (smID >= 0) && (smID < smStatusArrayLen) )
+        {
+            pos = smStatusArray[smID].offStart + smStatusArray[smID].offCount;
+            sorted[pos] = offFrameArray[i];
+            aux_clearCANFrame(&(offCANFrames[pos]));
+            hapcan_getCANDataFromHAPCAN(&(offFrameArray[i].frame), 
+                &(offCANFrames[pos]));
+            smStatusArray[smID].offCount++;
+        }
+    }
+    free(offFrameArray);
+    offFrameArray = sorted;
+    offFrameArrayLen = start;
 }
 
 // Update offFrameArray and offFrameArrayLen based on its current values and the
@@ -336,6 +473,536 @@ static void getLoadOffInfo(harpiSMLoadsData* load, hlFrameInfo_t* frame_info)
     }
 }
 
+// Key of a load: frametype (12 bits), node, group and channel
+static uint64_t getLoadKey(uint16_t frametype, uint8_t node, uint8_t group, 
+    uint8_t channel)
+{
+    return ((uint64_t)(frametype & 0x0FFF) << 24) | ((uint64_t)node << 16) | 
+        ((uint64_t)group << 8) | (uint64_t)channel;
+}
+
+// Status frame type of a load type (0: not indexed)
+static uint16_t getLoadFrameType(harpiLoadType_t type)
+{
+    switch(type)
+    {
+        case HARPI_LOAD_TYPE_RELAY:
+            return HAPCAN_RELAY_FRAME_TYPE;
+        default:
+            return 0;
+    }
+}
+
+// Hash (Fibonacci hashing) - the mask selects the bucket
+static uint32_t hashKey(uint64_t key)
+{
+    key = key * 0x9E3779B97F4A7C15ULL;
+    return (uint32_t)(key >> 32);
+}
+
+// Sort keys: by key, then by load (keeps the configuration order)
+static int compareKeys(const void* a, const void* b)
+{
+    const hlKey_t* ka = a;
+    const hlKey_t* kb = b;
+    if(ka->key != kb->key)
+    {
+        return (ka->key < kb->key) ? -1 : 1;
+    }
+    return (int)ka->load - (int)kb->load;
+}
+
+// Free the loads index
+static void freeLoadsIndex(void)
+{
+    free(loadsByKey);
+    loadsByKey = NULL;
+    free(loadsBuckets);
+    loadsBuckets = NULL;
+    loadsBucketsMask = 0;
+}
+
+// Index the loads by key (after initLoadsArray): loads grouped by key and a 
+// hash table (open addressing) of the groups
+static void initLoadsIndex(void)
+{
+    hlKey_t* keys;
+    uint32_t size;
+    uint32_t h;
+    uint16_t frametype;
+    int16_t len;
+    int16_t i;
+    int16_t j;
+    freeLoadsIndex();
+    if(loadsStatusArrayLen <= 0)
+    {
+        return;
+    }
+    keys = (hlKey_t*)malloc(loadsStatusArrayLen * sizeof(hlKey_t));
+    loadsByKey = (int16_t*)malloc(loadsStatusArrayLen * sizeof(int16_t));
+    // Table size: power of 2, at least twice the number of loads
+    size = 2;
+    while(size < (2U * (uint32_t)loadsStatusArrayLen))
+    {
+        size = size << 1;
+    }
+    loadsBuckets = (hlBucket_t*)calloc(size, sizeof(hlBucket_t));
+    if( (keys == NULL) || (loadsByKey == NULL) || (loadsBuckets == NULL) )
+    {
+        #ifdef DEBUG_HARPILOADS_ERRORS
+        debug_print("harpiloads_load error - index memory!\n");
+        #endif
+        free(keys);
+        freeLoadsIndex();
+        return;
+    }
+    loadsBucketsMask = size - 1;
+    // Keys of the loads with status frames
+    len = 0;
+    for(i = 0; i < loadsStatusArrayLen; i++)
+    {
+        frametype = getLoadFrameType(loadsStatusArray[i].load.type);
+        if(frametype == 0)
+        {
+            continue;
+        }
+        keys[len].key = getLoadKey(frametype, loadsStatusArray[i].load.node, 
+            loadsStatusArray[i].load.group, loadsStatusArray[i].load.channel);
+        keys[len].load = i;
+        len++;
+    }
+    qsort(keys, len, sizeof(hlKey_t), compareKeys);
+    for(i = 0; i < len; i = j)
+    {
+        // Loads with the same key
+        for(j = i; (j < len) && (keys[j].key == keys[i].key); j++)
+        {
+            loadsByKey[j] = keys[j].load;
+        }
+        h = hashKey(keys[i].key) & loadsBucketsMask;
+        while(loadsBuckets[h].count != 0)
+        {
+            h = (h + 1) & loadsBucketsMask;
+        }
+        loadsBuckets[h].key = keys[i].key;
+        loadsBuckets[h].start = i;
+        loadsBuckets[h].count = j - i;
+    }
+    free(keys);
+}
+
+// Get the loads of a key: loadsByKey[start..start+count-1] (count 0 if none)
+static int16_t lookupLoads(uint64_t key, int16_t* count)
+{
+    uint32_t h;
+    *count = 0;
+    if(loadsBuckets == NULL)
+    {
+        return 0;
+    }
+    h = hashKey(key) & loadsBucketsMask;
+    while(loadsBuckets[h].count != 0)
+    {
+        if(loadsBuckets[h].key == key)
+        {
+            *count = loadsBuckets[h].count;
+            return loadsBuckets[h].start;
+        }
+        h = (h + 1) & loadsBucketsMask;
+    }
+    return 0;
+}
+
+// State machine status from its counters:
+// - If any load is uninitialized, it is undefined
+// - If all are initialized, and any is ON, it is ON
+// - If all are initialized, and all are OFF, it is OFF
+static void updateSMStatus(hlSM_t* sm)
+{
+    if(sm->loads <= 0)
+    {
+        sm->status = HARPI_LOAD_STATUS_NO_LOADS;
+    }
+    else if(sm->loadsUndefined > 0)
+    {
+        sm->status = HARPI_LOAD_STATUS_UNDEFINED;
+    }
+    else if(sm->loadsON > 0)
+    {
+        sm->status = HARPI_LOAD_STATUS_ON;
+    }
+    else
+    {
+        sm->status = HARPI_LOAD_STATUS_OFF;
+    }
+}
+
+// Set the status of a load and update the counters of its state machine
+static void setLoadStatus(int16_t i_Load, harpiLoadStatus_t status)
+{
+    hlLoads_t* load;
+    hlSM_t* sm;
+    int16_t smID;
+    load = &loadsStatusArray[i_Load];
+    if(load->status == status)
+    {
+        return;
+    }
+    smID = load->load.stateMachineID;
+    if( (smID >= 0) && (smID < smStatusArrayLen) )
+    {
+        sm = &smStatusArray[smID];
+        sm->loadsON -= (load->status == HARPI_LOAD_STATUS_ON);
+        sm->loadsUndefined -= (load->status == HARPI_LOAD_STATUS_UNDEFINED);
+        sm->loadsON += (status == HARPI_LOAD_STATUS_ON);
+        sm->loadsUndefined += (status == HARPI_LOAD_STATUS_UNDEFINED);
+        updateSMStatus(sm);
+    }
+    if( (load->status == HARPI_LOAD_STATUS_UNDEFINED) && (load->node >= 0) )
+    {
+        nodesArray[load->node].undefined--;
+        if(nodesArray[load->node].undefined == 0)
+        {
+            setNodeDefined(&nodesArray[load->node]);
+        }
+    }
+    load->status = status;
+}
+
+// Monotonic time - ms
+static uint64_t getms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+// Nodes (node, group) of the loads, sorted by group and node (after 
+// initLoadsArray), and discovery restart
+static void initDiscovery(void)
+{
+    hlKey_t* keys;
+    int16_t i;
+    // Init array and discovery
+    if(nodesArray != NULL)
+    {
+        free(nodesArray);
+        nodesArray = NULL;
+    }
+    nodesArrayLen = 0;
+    memset(&discovery, 0, sizeof(hlDiscovery_t));
+    discovery.start = getms();
+    if(loadsStatusArrayLen <= 0)
+    {
+        discovery.done = discovery.start;
+        return;
+    }
+    keys = (hlKey_t*)malloc(loadsStatusArrayLen * sizeof(hlKey_t));
+    nodesArray = (hlNode_t*)malloc(loadsStatusArrayLen * sizeof(hlNode_t));
+    if( (keys == NULL) || (nodesArray == NULL) )
+    {
+        #ifdef DEBUG_HARPILOADS_ERRORS
+        debug_print("harpiloads_load error - nodes memory!\n");
+        #endif
+        free(keys);
+        free(nodesArray);
+        nodesArray = NULL;
+        for(i = 0; i < loadsStatusArrayLen; i++)
+        {
+            loadsStatusArray[i].node = DISCOVERY_NONE;
+        }
+        return;
+    }
+    for(i = 0; i < loadsStatusArrayLen; i++)
+    {
+        keys[i].key = ((uint64_t)loadsStatusArray[i].load.group << 8) | 
+            (uint64_t)loadsStatusArray[i].load.node;
+        keys[i].load = i;
+    }
+    qsort(keys, loadsStatusArrayLen, sizeof(hlKey_t), compareKeys);
+    // One node per key - all the loads are undefined
+    for(i = 0; i < loadsStatusArrayLen; i++)
+    {
+        if( (i == 0) || (keys[i].key != keys[i - 1].key) )
+        {
+            nodesArray[nodesArrayLen].node = (uint8_t)(keys[i].key & 0xFF);
+            nodesArray[nodesArrayLen].group = (uint8_t)(keys[i].key >> 8);
+            nodesArray[nodesArrayLen].undefined = 0;
+            nodesArray[nodesArrayLen].request = DISCOVERY_NONE;
+            nodesArray[nodesArrayLen].retries = 0;
+            nodesArray[nodesArrayLen].notBefore = discovery.start + 
+                HARPILOADS_DISCOVERY_DELAY;
+            nodesArray[nodesArrayLen].refreshed = 0;
+            nodesArrayLen++;
+        }
+        loadsStatusArray[keys[i].load].node = nodesArrayLen - 1;
+        nodesArray[nodesArrayLen - 1].undefined++;
+    }
+    free(keys);
+    discovery.refreshTime = discovery.start;
+    discovery.undefined = nodesArrayLen;
+    discovery.stats.nodes = nodesArrayLen;
+}
+
+// All the loads of a node are defined: release its request and check if the 
+// discovery is complete
+static void setNodeDefined(hlNode_t* node)
+{
+    if(node->request != DISCOVERY_NONE)
+    {
+        discovery.requests[node->request].pending--;
+        node->request = DISCOVERY_NONE;
+    }
+    node->retries = 0;
+    discovery.undefined--;
+    if( (discovery.undefined == 0) && (discovery.done == 0) )
+    {
+        discovery.done = getms();
+        #ifdef DEBUG_HARPILOADS_DISCOVERY
+        debug_print("harpiloads - full state: %d nodes in %llu ms (%llu node "
+            "requests, %llu group requests, %llu timeouts)\n", nodesArrayLen,
+            (unsigned long long)(discovery.done - discovery.start),
+            discovery.stats.nodeRequests, discovery.stats.groupRequests,
+            discovery.stats.timeouts);
+        #endif
+    }
+}
+
+// Requests in flight: release the expired ones (nodes retried or, after 
+// HARPILOADS_DISCOVERY_RETRIES, requested again after the backoff)
+static void checkRequests(uint64_t now)
+{
+    int16_t i_Req;
+    int16_t i;
+    hlRequest_t* request;
+    for(i_Req = 0; i_Req < HARPILOADS_DISCOVERY_WINDOW; i_Req++)
+    {
+        request = &discovery.requests[i_Req];
+        if( (request->pending == 0) || (now < request->deadline) )
+        {
+            continue;
+        }
+        discovery.stats.timeouts++;
+        for(i = 0; i < nodesArrayLen; i++)
+        {
+            if(nodesArray[i].request != i_Req)
+            {
+                continue;
+            }
+            nodesArray[i].request = DISCOVERY_NONE;
+            nodesArray[i].retries++;
+            if(nodesArray[i].retries > HARPILOADS_DISCOVERY_RETRIES)
+            {
+                nodesArray[i].retries = 0;
+                nodesArray[i].notBefore = now + HARPILOADS_DISCOVERY_BACKOFF;
+                #ifdef DEBUG_HARPILOADS_ERRORS
+                debug_print("harpiloads_periodic - no status: node %d, "
+                    "group %d\n", nodesArray[i].node, nodesArray[i].group);
+                #endif
+            }
+        }
+        request->pending = 0;
+    }
+}
+
+// Free request (DISCOVERY_NONE if the window is full)
+static int16_t getFreeRequest(void)
+{
+    int16_t i_Req;
+    for(i_Req = 0; i_Req < HARPILOADS_DISCOVERY_WINDOW; i_Req++)
+    {
+        if(discovery.requests[i_Req].pending == 0)
+        {
+            return i_Req;
+        }
+    }
+    return DISCOVERY_NONE;
+}
+
+// Fill the window: status request to group for the first attempt of 
+// HARPILOADS_DISCOVERY_GROUP_MIN (or more) nodes of a group, status request 
+// to node otherwise
+// OUTPUT: frames (to be sent)
+static int16_t addRequests(uint64_t now, hapcanCANData* frames, 
+    int16_t maxFrames)
+{
+    int16_t frameCount;
+    int16_t i_Req;
+    int16_t i;
+    int16_t j;
+    int16_t end;
+    int16_t count;
+    bool waiting;
+    frameCount = 0;
+    for(i = 0; (i < nodesArrayLen) && (frameCount < maxFrames); i = end)
+    {
+        // Nodes of the group: nodesArray[i..end-1]
+        count = 0;
+        for(end = i; (end < nodesArrayLen) && 
+            (nodesArray[end].group == nodesArray[i].group); end++)
+        {
+            waiting = (nodesArray[end].undefined > 0);
+            waiting = waiting && (nodesArray[end].request == DISCOVERY_NONE);
+            waiting = waiting && (now >= nodesArray[end].notBefore);
+            count += (waiting && (nodesArray[end].retries == 0));
+        }
+        // Group request (group 0 is not a group)
+        if( (count >= HARPILOADS_DISCOVERY_GROUP_MIN) && 
+            (nodesArray[i].group != 0) )
+        {
+            i_Req = getFreeRequest();
+            if(i_Req == DISCOVERY_NONE)
+            {
+                break;
+            }
+            for(j = i; j < end; j++)
+            {
+                waiting = (nodesArray[j].undefined > 0);
+                waiting = waiting && (nodesArray[j].request == DISCOVERY_NONE);
+                waiting = waiting && (now >= nodesArray[j].notBefore);
+                if(waiting && (nodesArray[j].retries == 0))
+                {
+                    nodesArray[j].request = i_Req;
+                }
+            }
+            discovery.requests[i_Req].pending = count;
+            discovery.requests[i_Req].deadline = now + 
+                HARPILOADS_DISCOVERY_TIMEOUT;
+            hapcan_getSystemFrame(&frames[frameCount], 
+                HAPCAN_STATUS_REQUEST_GROUP_FRAME_TYPE, 0xFF, 
+                nodesArray[i].group);
+            frameCount++;
+            discovery.stats.groupRequests++;
+        }
+        // Node requests (retries or nodes alone in the group)
+        for(j = i; (j < end) && (frameCount < maxFrames); j++)
+        {
+            waiting = (nodesArray[j].undefined > 0);
+            waiting = waiting && (nodesArray[j].request == DISCOVERY_NONE);
+            waiting = waiting && (now >= nodesArray[j].notBefore);
+            if(!waiting)
+            {
+                continue;
+            }
+            i_Req = getFreeRequest();
+            if(i_Req == DISCOVERY_NONE)
+            {
+                return frameCount;
+            }
+            nodesArray[j].request = i_Req;
+            discovery.requests[i_Req].pending = 1;
+            discovery.requests[i_Req].deadline = now + 
+                HARPILOADS_DISCOVERY_TIMEOUT;
+            hapcan_getSystemFrame(&frames[frameCount], 
+                HAPCAN_STATUS_REQUEST_NODE_FRAME_TYPE, nodesArray[j].node, 
+                nodesArray[j].group);
+            frameCount++;
+            discovery.stats.nodeRequests++;
+        }
+    }
+    return frameCount;
+}
+
+// Load status refresh: status request to the node with the stalest loads 
+// (age relative to HARPILOADS_REFRESH_AGE or HARPILOADS_REFRESH_ACTIVE_AGE), 
+// within the HARPILOADS_REFRESH_RATE budget and only if the CAN Write Buffer
+// is idle (actions first)
+// OUTPUT: frame (to be sent)
+static int16_t addRefresh(uint64_t now, bool idle, hapcanCANData* frame)
+{
+    hlNode_t* node;
+    hlNode_t* best;
+    uint64_t age;
+    uint64_t bestAge;
+    uint64_t limit;
+    uint64_t bestLimit;
+    int16_t smID;
+    int16_t i;
+    //-------------------------------------------------
+    // Budget
+    //-------------------------------------------------
+    discovery.refreshCredit += (now - discovery.refreshTime) * 
+        HARPILOADS_REFRESH_RATE;
+    discovery.refreshTime = now;
+    if(discovery.refreshCredit > HARPILOADS_REFRESH_BURST * 1000ULL)
+    {
+        discovery.refreshCredit = HARPILOADS_REFRESH_BURST * 1000ULL;
+    }
+    if(discovery.refreshCredit < 1000ULL)
+    {
+        return 0;
+    }
+    //-------------------------------------------------
+    // Stalest load of each node (defined loads)
+    //-------------------------------------------------
+    for(i = 0; i < nodesArrayLen; i++)
+    {
+        nodesArray[i].oldest = now;
+        nodesArray[i].active = false;
+    }
+    for(i = 0; i < loadsStatusArrayLen; i++)
+    {
+        if( (loadsStatusArray[i].node < 0) || 
+            (loadsStatusArray[i].status == HARPI_LOAD_STATUS_UNDEFINED) )
+        {
+            continue;
+        }
+        node = &nodesArray[loadsStatusArray[i].node];
+        if(loadsStatusArray[i].confirmed < node->oldest)
+        {
+            node->oldest = loadsStatusArray[i].confirmed;
+        }
+        smID = loadsStatusArray[i].load.stateMachineID;
+        if( (smID >= 0) && (smID < smStatusArrayLen) && 
+            (smStatusArray[smID].loadsON > 0) )
+        {
+            node->active = true;
+        }
+    }
+    //-------------------------------------------------
+    // Stalest node (nodes with undefined loads: see addRequests)
+    //-------------------------------------------------
+    best = NULL;
+    bestAge = 0;
+    bestLimit = 1;
+    for(i = 0; i < nodesArrayLen; i++)
+    {
+        node = &nodesArray[i];
+        if( (node->undefined > 0) || (node->request != DISCOVERY_NONE) )
+        {
+            continue;
+        }
+        age = now - ((node->refreshed > node->oldest) ? node->refreshed : 
+            node->oldest);
+        limit = node->active ? HARPILOADS_REFRESH_ACTIVE_AGE : 
+            HARPILOADS_REFRESH_AGE;
+        if( (age >= limit) && (age * bestLimit > bestAge * limit) )
+        {
+            best = node;
+            bestAge = age;
+            bestLimit = limit;
+        }
+    }
+    if(best == NULL)
+    {
+        return 0;
+    }
+    if(!idle)
+    {
+        discovery.stats.refreshDeferred++;
+        return 0;
+    }
+    //-------------------------------------------------
+    // Status request to node
+    //-------------------------------------------------
+    hapcan_getSystemFrame(frame, HAPCAN_STATUS_REQUEST_NODE_FRAME_TYPE, 
+        best->node, best->group);
+    best->refreshed = now;
+    discovery.refreshCredit -= 1000ULL;
+    discovery.stats.refreshRequests++;
+    return 1;
+}
+
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
@@ -353,12 +1020,16 @@ void harpiloads_init(void)
         harpiSMLoadsArray = NULL;
     }
     harpiSMLoadsArrayLen = 0;
-    // Init periodic check
-    periodInfo.current_delay = 0;
-    periodInfo.initial_delay = 0;
-    periodInfo.wait = WAIT_DELAY_NORMAL;
-    periodInfo.last_group = 0;
-    periodInfo.last_node = 0;
+    // Init index
+    freeLoadsIndex();
+    // Init periodic check (load status discovery)
+    if(nodesArray != NULL)
+    {
+        free(nodesArray);
+        nodesArray = NULL;
+    }
+    nodesArrayLen = 0;
+    memset(&discovery, 0, sizeof(hlDiscovery_t));
     // UNLOCK
     pthread_mutex_unlock(&g_SMLoads_mutex);
 }
@@ -397,209 +1068,107 @@ void harpiloads_load(harpiLinkedList* element)
     initLoadsArray();
     initStateMachinesArray();
     initOffFramesArray();
+    initLoadsIndex();
+    initDiscovery();
     // UNLOCK
     pthread_mutex_unlock(&g_SMLoads_mutex);
 }
 
 void harpiloads_periodic(void)
 {
-    int16_t i_Load;
-    uint8_t node;
-    uint8_t group;
-    bool update;
-    hapcanCANData hd_result;
-    unsigned long long timestamp;
+    hapcanCANData frames[HARPILOADS_DISCOVERY_WINDOW];
+    int16_t frameCount;
+    uint64_t now;
+    bool idle;
     int ret;
-    // Init
-    ret = HAPCAN_NO_RESPONSE;
-    update = false;
     //-------------------------------------------------
-    // Update counters - Do not need thread protection
+    // Expired requests and new requests (nodes with undefined loads), then 
+    // refresh (stale loads)
     //-------------------------------------------------
-    if(periodInfo.initial_delay < INITIAL_DELAY)
+    now = getms();
+    idle = (hapcan_getCANWritePending() == 0);
+    frameCount = 0;
+    // LOCK
+    pthread_mutex_lock(&g_SMLoads_mutex);
+    if(discovery.undefined > 0)
     {
-        periodInfo.initial_delay++;
+        checkRequests(now);
+        frameCount = addRequests(now, frames, HARPILOADS_DISCOVERY_WINDOW);
     }
-    if(periodInfo.current_delay < WAIT_DELAY_ERROR)
+    if(frameCount == 0)
     {
-        periodInfo.current_delay++;
+        frameCount = addRefresh(now, idle, frames);
     }
-    // Check if initial delay is over and wait is over
-    if(periodInfo.initial_delay >= INITIAL_DELAY && 
-        periodInfo.current_delay >= periodInfo.wait)
+    // UNLOCK
+    pthread_mutex_unlock(&g_SMLoads_mutex);
+    //-------------------------------------------------
+    // Request STATUS update (outside g_SMLoads_mutex)
+    //-------------------------------------------------
+    if(frameCount > 0)
     {
-        // LOCK
-        pthread_mutex_lock(&g_SMLoads_mutex);
-        //-------------------------------------------------
-        // Check all loads to define which status is missing
-        //-------------------------------------------------
-        if(loadsStatusArrayLen > 0)
-        {
-            for(i_Load = 0; i_Load < loadsStatusArrayLen; i_Load++)
-            {
-                if(loadsStatusArray[i_Load].status == 
-                    HARPI_LOAD_STATUS_UNDEFINED)
-                {
-                    update = true;
-                    node = loadsStatusArray[i_Load].load.node;
-                    group = loadsStatusArray[i_Load].load.group;
-                    break;
-                }
-            }
-        }
-        // UNLOCK
-        pthread_mutex_unlock(&g_SMLoads_mutex);
-    }
-    // Check if update is needed
-    if(update)
-    {
-        //-------------------------------------------------
-        // Request STATUS update for the given module
-        //-------------------------------------------------
-        hapcan_getSystemFrame(&hd_result,
-                HAPCAN_STATUS_REQUEST_NODE_FRAME_TYPE, node, group);
-        // Get Timestamp
-        timestamp = aux_getmsSinceEpoch();
-        ret = hapcan_addToCANWriteBuffer(&hd_result, timestamp);
+        ret = hapcan_addToCANWriteBufferN(frames, frameCount, 
+            CAN_LANE_BACKGROUND, aux_getmsSinceEpoch());
         if(ret == HAPCAN_CAN_RESPONSE_ERROR)
         {
             #ifdef DEBUG_HARPILOADS_ERRORS
             debug_print("harpiloads_periodic error: CAN Write!\n");
             #endif
         }
-        //-------------------------------------------------
-        // Update timers - no thread protection needed
-        //-------------------------------------------------
-        periodInfo.current_delay = 0;
-        // Check if it is the same as the last sent
-        if( (periodInfo.last_node == node) && 
-            (periodInfo.last_group == group) )
-        {
-            periodInfo.wait = WAIT_DELAY_ERROR;
-            #ifdef DEBUG_HARPILOADS_ERRORS
-            debug_print("harpiloads_periodic - Load Status retry!\n");
-            debug_print("Retry: node %d, group %d: %d\n", node, group);
-            #endif
-        }
-        else
-        {
-            periodInfo.wait = WAIT_DELAY_NORMAL;
-        }
-        // Update last sent
-        periodInfo.last_group = group;
-        periodInfo.last_node = node;
-    }    
+    }
 }
 
 void harpiloads_handleCAN(hapcanCANData* hapcanData, 
         unsigned long long timestamp)
 {
-    harpiLoadType_t type;
-    harpiSMLoadsData load;
-    int16_t i_Load;
-    int16_t i_SM;
-    bool update;
-    bool update_sm;
     harpiLoadStatus_t status;
-    int16_t smID;
-    // Init to default
-    type = HARPI_LOAD_TYPE_OTHER;
-    update = false;
-    update_sm = false;
+    uint64_t key;
+    uint64_t now;
+    int16_t start;
+    int16_t count;
+    int16_t i;
     //---------------------------------------
-    // Check the frame type
+    // Check the frame type: new status
     //---------------------------------------
     switch(hapcanData->frametype)
     {
+        //---------------------------------------
+        // Relay: Node, Group, Channel
+        //---------------------------------------
         case HAPCAN_RELAY_FRAME_TYPE:
-            type = HARPI_LOAD_TYPE_RELAY;
+            if(hapcanData->data[STATUS_BYTE] == 0x00)
+            {
+                // Load is OFF
+                status = HARPI_LOAD_STATUS_OFF;
+            }
+            else if(hapcanData->data[STATUS_BYTE] == 0xFF)
+            {
+                // Load is ON
+                status = HARPI_LOAD_STATUS_ON;
+            }
+            else
+            {
+                return;
+            }
+            key = getLoadKey(hapcanData->frametype, hapcanData->module, 
+                hapcanData->group, hapcanData->data[CHANNEL_BYTE]);
             break;
+        //---------------------------------------
+        // Default: not updated
+        //---------------------------------------
         default:
-            break;
+            return;
     }
     //---------------------------------------
-    // Check load and frame
+    // Update the loads of the frame (and their state machines)
     //---------------------------------------
+    now = getms();
     // LOCK
     pthread_mutex_lock(&g_SMLoads_mutex);
-    for(i_Load = 0; i_Load < loadsStatusArrayLen; i_Load++)
+    start = lookupLoads(key, &count);
+    for(i = start; i < start + count; i++)
     {
-        load = loadsStatusArray[i_Load].load;
-        if(type == load.type)
-        {
-            switch(type)
-            {
-                //---------------------------------------
-                // Relay: Check Node, Group, Channel
-                //---------------------------------------
-                case HARPI_LOAD_TYPE_RELAY:
-                    update = (load.channel == hapcanData->data[CHANNEL_BYTE]);
-                    update = update && (load.node == hapcanData->module);
-                    update = update && (load.group == hapcanData->group);
-                    // Check if match was found
-                    if(update)
-                    {
-                        if(hapcanData->data[STATUS_BYTE] == 0x00)
-                        {
-                            // Load is OFF
-                            loadsStatusArray[i_Load].status = 
-                                HARPI_LOAD_STATUS_OFF;
-                        }
-                        else if(hapcanData->data[STATUS_BYTE] == 0xFF)
-                        {
-                            // Load is ON
-                            loadsStatusArray[i_Load].status = 
-                                HARPI_LOAD_STATUS_ON;
-                        }
-                        // Update State Machines
-                        update_sm = true;
-                    }
-                    break;
-                //---------------------------------------
-                // Default: not updated
-                //---------------------------------------
-                default:
-                    update = false;
-                    break;
-            }
-        }        
-    }
-    //---------------------------------------
-    // Check the loads to update the state machine status
-    //---------------------------------------
-    if(update_sm)
-    {
-        // At least one load changed - check all
-        for(i_SM = 0; i_SM < smStatusArrayLen; i_SM++)
-        {
-            smID = smStatusArray[i_SM].stateMachineID;
-            //------------------------------------------
-            // - If any is uninitialized, it is undefined
-            // - If all are initialized, and any is ON, it is ON
-            // - If all are initialized, and all are OFF, it is OFF
-            //------------------------------------------
-            status = HARPI_LOAD_STATUS_OFF;
-            for(i_Load = 0; i_Load < loadsStatusArrayLen; i_Load++)
-            {
-                // Check if state machine ID is the same
-                if(loadsStatusArray[i_Load].load.stateMachineID == smID)
-                {
-                    if(loadsStatusArray[i_Load].status == 
-                        HARPI_LOAD_STATUS_UNDEFINED)
-                    {
-                        // Undefined - set as undefined and leave
-                        status = HARPI_LOAD_STATUS_UNDEFINED;
-                        break;
-                    }
-                    if(loadsStatusArray[i_Load].status == HARPI_LOAD_STATUS_ON)
-                    {
-                        // Set as ON, and check remaining for undefined
-                        status = HARPI_LOAD_STATUS_ON;
-                    }
-                }
-            }
-            smStatusArray[i_SM].status = status;
-        }
+        setLoadStatus(loadsByKey[i], status);
+        loadsStatusArray[loadsByKey[i]].confirmed = now;
     }
     // UNLOCK
     pthread_mutex_unlock(&g_SMLoads_mutex);
@@ -607,82 +1176,80 @@ void harpiloads_handleCAN(hapcanCANData* hapcanData,
 
 harpiLoadStatus_t harpiloads_isAnyLoadON(int16_t stateMachineID)
 {
-    int16_t i_SM;
     harpiLoadStatus_t status;
-    int16_t smID;
     // Init - If no state machine is matched, no load is available for the ID
     status = HARPI_LOAD_STATUS_NO_LOADS;
-    // Check the state machines
     // LOCK
     pthread_mutex_lock(&g_SMLoads_mutex);
-    // Check all state machine IDs
-    for(i_SM = 0; i_SM < smStatusArrayLen; i_SM++)
+    // Status of the state machine
+    if( (stateMachineID >= 0) && (stateMachineID < smStatusArrayLen) )
     {
-        smID = smStatusArray[i_SM].stateMachineID;
-        if(smID == stateMachineID)
-        {
-            status = smStatusArray[i_SM].status;
-            break;
-        }
+        status = smStatusArray[stateMachineID].status;
     }
     // UNLOCK
     pthread_mutex_unlock(&g_SMLoads_mutex);
     return status;
 }
 
-void harpiloads_setLoadsOFF(int16_t stateMachineID)
+int16_t harpiloads_getLoadsOFF(int16_t stateMachineID, 
+        struct can_frame* frames, int16_t maxFrames)
 {
-    int16_t check;
-    int16_t i;
-    unsigned long long millisecondsSinceEpoch;
     int16_t frameCount;
-    // Get Timestamp
-    millisecondsSinceEpoch = aux_getmsSinceEpoch();
-    //------------------------------------------------
-    // Avoid nested mutex locks from g_SMLoads_mutex and 
-    // hapcan_addToCANWriteBuffer: First create an array of frames to be sent, 
-    // then send them
-    //------------------------------------------------
-    // 1. Prepare frames to be sent - LOCK needed
-    //------------------------------------------------
     // Init counter
     frameCount = 0;
+    // LOCK
     pthread_mutex_lock(&g_SMLoads_mutex);
-    // Check all elements of the array
-    for(i = 0; i < offFrameArrayLen; i++)
+    // Frames of the state machine (a single range)
+    if( (stateMachineID >= 0) && (stateMachineID < smStatusArrayLen) && 
+        (offCANFrames != NULL) )
     {
-        // Check for a match
-        if(offFrameArray[i].stateMachineID == stateMachineID)
+        frameCount = smStatusArray[stateMachineID].offCount;
+        if(frameCount > maxFrames)
         {
-            // Add to frames to be sent
-            memcpy(&(frames[frameCount]), &(offFrameArray[i].frame), 
-                sizeof(hapcanCANData));
-            frameCount++;
-            if(frameCount >= MAXIMUM_ACTIONS)
-            {
-                #ifdef DEBUG_HARPILOADS_ERRORS
-                debug_print("harpiloads_setLoadsOFF - ERROR: max actions!\n");
-                #endif
-                break;
-            }
+            #ifdef DEBUG_HARPILOADS_ERRORS
+            debug_print("harpiloads_getLoadsOFF - ERROR: max actions!\n");
+            #endif
+            frameCount = maxFrames;
         }
+        // Add to frames to be sent
+        memcpy(frames, &(offCANFrames[smStatusArray[stateMachineID].offStart]),
+            frameCount * sizeof(struct can_frame));
     }
     // UNLOCK
     pthread_mutex_unlock(&g_SMLoads_mutex);
-    //---------------------------------
-    // 2. Send Frames - LOCK not needed
-    //---------------------------------
-    // Check all elements of the array
-    for(i = 0; i < frameCount; i++)
-    {
-        // Found - Send CAN Frame for action
-        check = hapcan_addToCANWriteBuffer(&(frames[i]), 
-            millisecondsSinceEpoch);
-        if(check != HAPCAN_CAN_RESPONSE)
+    return frameCount;
+}
+
+void harpiloads_getDiscoveryStats(harpiLoadsDiscoveryStats_t* stats)
+{
+    uint64_t now;
+    int16_t i_Req;
+    int16_t i;
+    // LOCK
+    pthread_mutex_lock(&g_SMLoads_mutex);
+    *stats = discovery.stats;
+    stats->undefined = discovery.undefined;
+    stats->inFlight = 0;
+    for(i_Req = 0; i_Req < HARPILOADS_DISCOVERY_WINDOW; i_Req++)
+    {
+        stats->inFlight += (discovery.requests[i_Req].pending > 0);
+    }
+    stats->complete = (discovery.done != 0);
+    stats->timeToFullState = 0;
+    if(stats->complete)
+    {
+        stats->timeToFullState = discovery.done - discovery.start;
+    }
+    stats->oldestConfirmed = 0;
+    now = getms();
+    for(i = 0; i < loadsStatusArrayLen; i++)
+    {
+        if( (loadsStatusArray[i].status != HARPI_LOAD_STATUS_UNDEFINED) && 
+            (now - loadsStatusArray[i].confirmed > stats->oldestConfirmed) )
         {
-            #ifdef DEBUG_HARPILOADS_ERRORS
-            debug_print("harpiloads_setLoadsOFF - ERROR: CAN write!\n");
-            #endif
+            stats->oldestConfirmed = now - loadsStatusArray[i].confirmed;
         }
     }
+    // UNLOCK
+    pthread_mutex_unlock(&g_SMLoads_mutex);
 }
\ No newline at end of file
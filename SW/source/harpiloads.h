@@ -6,6 +6,21 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - harpiloads_getLoadsOFF: frames sent later by the caller                  //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Load status discovery: request window, group requests, stats             //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - Load status refresh (stale loads, HARPILOADS_REFRESH_RATE budget)        //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - Loads OFF frames encoded (struct can_frame) when loading                 //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - harpiloads_setLoadsOFF removed (see harpiloads_getLoadsOFF)              //
+//----------------------------------------------------------------------------//
 
 #ifndef HARPILOADS_H
 #define HARPILOADS_H
@@ -21,12 +36,37 @@ extern "C" {
 //----------------------------------------------------------------------------//
 // EXTERNAL DEFINITIONS
 //----------------------------------------------------------------------------//    
-
+// Load status discovery (see harpiloads_periodic)
+#define HARPILOADS_DISCOVERY_DELAY      5000  // ms - first request after load
+#define HARPILOADS_DISCOVERY_WINDOW     8     // Requests waiting for answer
+#define HARPILOADS_DISCOVERY_TIMEOUT    500   // ms - answer to a request
+#define HARPILOADS_DISCOVERY_RETRIES    2     // Retries before the backoff
+#define HARPILOADS_DISCOVERY_BACKOFF    30000 // ms - nodes not answering
+#define HARPILOADS_DISCOVERY_GROUP_MIN  2     // Nodes for a group request
+// Load status refresh (see harpiloads_periodic)
+#define HARPILOADS_REFRESH_RATE         2      // Status requests per second
+#define HARPILOADS_REFRESH_BURST        4      // Status requests after idle
+#define HARPILOADS_REFRESH_AGE          600000 // ms - stale loads
+#define HARPILOADS_REFRESH_ACTIVE_AGE   60000  // ms - stale loads (active SM)
     
 //----------------------------------------------------------------------------//
 // EXTERNAL TYPES
 //----------------------------------------------------------------------------//
-
+// Load status discovery and refresh statistics
+typedef struct
+{
+    int16_t nodes;                      // Nodes (node, group) with loads
+    int16_t undefined;                  // Nodes with undefined loads
+    int16_t inFlight;                   // Requests waiting for answer
+    unsigned long long nodeRequests;    // Status requests to node
+    unsigned long long groupRequests;   // Status requests to group
+    unsigned long long timeouts;        // Requests not fully answered
+    bool complete;                      // All loads defined
+    unsigned long long timeToFullState; // ms since load (if complete)
+    unsigned long long refreshRequests; // Status requests to node (refresh)
+    unsigned long long refreshDeferred; // Refresh delayed (CAN Write busy)
+    unsigned long long oldestConfirmed; // ms - stalest (defined) load
+} harpiLoadsDiscoveryStats_t;
     
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
@@ -46,7 +86,16 @@ void harpiloads_init(void);
 void harpiloads_load(harpiLinkedList* element);
 
 /**
- * Periodic check for unitialized loads
+ * Periodic check for unitialized loads (load status discovery): status 
+ * requests for the nodes with undefined loads, one per node and group, up to
+ * HARPILOADS_DISCOVERY_WINDOW requests waiting for answer. Nodes of the same 
+ * group are requested together (status request to group) on the first 
+ * attempt.
+ * Afterwards (load status refresh), the nodes with stale loads are requested 
+ * again, the stalest first, up to HARPILOADS_REFRESH_RATE requests per second
+ * and only when no frames (actions) are waiting to be sent. Loads of active 
+ * state machines (any load ON) are stale after HARPILOADS_REFRESH_ACTIVE_AGE,
+ * the others after HARPILOADS_REFRESH_AGE.
  * 
  **/
 void harpiloads_periodic(void);
@@ -54,7 +103,8 @@ void harpiloads_periodic(void);
 /**
  * Check the CAN message received for updating loads status
  * \param   hapcanData      (INPUT) received HAPCAN Frame
- *          timestamp       (INPUT) Received message timestamp
+ *          timestamp       (INPUT) Received message timestamp (ns since
+ *                          epoch - kernel receive time)
  * 
  */
 void harpiloads_handleCAN(hapcanCANData* hapcanData, 
@@ -68,11 +118,23 @@ void harpiloads_handleCAN(hapcanCANData* hapcanData,
 harpiLoadStatus_t harpiloads_isAnyLoadON(int16_t stateMachineID);
 
 /**
- * Turn OFF the loads of a given state machine
- * \param   stateMachineID (INPUT) The state machine ID
+ * Get the frames turning OFF the loads of a given state machine, encoded for 
+ * the CAN socket (sent by the caller with the state machine actions)
+ * \param   stateMachineID  (INPUT) The state machine ID
+ *          frames          (OUTPUT) frames to be sent
+ *          maxFrames       (INPUT) size of "frames"
  * 
+ * \return  number of frames
  **/
-void harpiloads_setLoadsOFF(int16_t stateMachineID);
+int16_t harpiloads_getLoadsOFF(int16_t stateMachineID, 
+        struct can_frame* frames, int16_t maxFrames);
+
+/**
+ * Get the load status discovery and refresh statistics (since the last load)
+ * \param   stats   (OUTPUT) statistics
+ * 
+ */
+void harpiloads_getDiscoveryStats(harpiLoadsDiscoveryStats_t* stats);
 
 
 
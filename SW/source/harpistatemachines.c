@@ -6,6 +6,45 @@
 //  1.00     | 01/Jun/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - harpism_handleEvents: immediate dispatch of events                       //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Reverse index: event set -> state machine rows (checkSMs)                //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - State machines compiled to [state][event] tables on load                 //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - State machines and event sets indexed by their (dense) IDs               //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - HARPISM_SHARDS: state machines checked by a pool of worker threads       //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - Actions / loads OFF collected while locked and sent after unlocking      //
+//----------------------------------------------------------------------------//
+//  1.07     | 16/Oct/2026 |                               | ALCP             //
+// - harpism_periodic: pending events checked in one batch                    //
+//----------------------------------------------------------------------------//
+//  1.08     | 16/Oct/2026 |                               | ALCP             //
+// - Timer expirations by callback; per state timeouts (CSV)                  //
+//----------------------------------------------------------------------------//
+//  1.09     | 16/Oct/2026 |                               | ALCP             //
+// - Dispatch output (actions, loads OFF) on the interactive write lane       //
+//----------------------------------------------------------------------------//
+//  1.10     | 16/Oct/2026 |                               | ALCP             //
+// - Dispatch output: encoded frames (no conversion when sending)             //
+//----------------------------------------------------------------------------//
+//  1.11     | 16/Oct/2026 |                               | ALCP             //
+// - pushShard: full shard buffer drops and counts events (no wait)           //
+//----------------------------------------------------------------------------//
+//  1.12     | 16/Oct/2026 |                               | ALCP             //
+// - harpism_periodic: events only with HARPI_IMMEDIATE_DISPATCH undefined    //
+//----------------------------------------------------------------------------//
+//  1.13     | 16/Oct/2026 |                               | ALCP             //
+// - initStateMachinesArrays: no state machines if out of memory              //
+//----------------------------------------------------------------------------//
 
 /*
 * Includes
@@ -17,8 +56,10 @@
 #include <stdbool.h>
 #include <limits.h>
 #include <pthread.h>
+#include <poll.h>
 #include <auxiliary.h>
 #include <debug.h>
+#include <spscbuf.h>
 #include <harpiactions.h>
 #include <harpievents.h>
 #include <harpiloads.h>
@@ -28,6 +69,24 @@
 //----------------------------------------------------------------------------//
 // INTERNAL DEFINITIONS
 //----------------------------------------------------------------------------//
+// Maximum [state][event] cells of a dense table (sorted sparse table if more)
+#define HARPISM_DENSE_MAX_CELLS 1024
+// Shards (state machine index % HARPISM_SHARD_COUNT)
+#ifdef HARPISM_SHARDS
+#define HARPISM_SHARD_COUNT HARPISM_SHARDS
+#else
+#define HARPISM_SHARD_COUNT 1
+#endif
+#define HARPISM_SHARD_BUFFER_SIZE   256     // Events buffer of each shard
+#define HARPISM_SHARD_BATCH         32      // Events pushed / checked at once
+#define HARPISM_SHARD_WAIT          1000    // us - no eventfd
+#define HARPISM_SHARD_POLL_TIMEOUT  1000    // ms - worker waiting for events
+// Requests kept in the output of a dispatch without allocating memory
+#define HARPISM_OUTPUT_SIZE         128
+// Frames sent at once when the output is flushed (>= MAXIMUM_ACTIONS)
+#define HARPISM_OUTPUT_FRAMES       (2 * MAXIMUM_ACTIONS)
+// Events drained from the events buffer at once (harpism_periodic)
+#define HARPISM_EVENTS_BATCH        64
 
 //----------------------------------------------------------------------------//
 // INTERNAL TYPES
@@ -36,9 +95,88 @@
 typedef struct  
 {
     int16_t stateMachineID;
-    int16_t currentStateID;
+    int16_t currentState;   // local state (smStates[stateStart + state])
+    int16_t states;         // local states (state ID 0 is local state 0)
+    int16_t events;         // local events
+    int32_t stateStart;     // smStates index
+    int32_t cellStart;      // smCells index
+    int32_t cellCount;
+    bool dense;             // cells: [state][event] / sorted by key
+    harpiTimerStatus_t timerStatus;
+    uint32_t timerSequence; // running timer (timer_setTimer)
 } hsmData_t;
 
+// Compiled cell: actions and next state for a local (state, event)
+typedef struct
+{
+    int32_t key;            // state * events + event
+    int32_t actionStart;    // smActions index
+    int16_t actionCount;
+    int16_t nextState;      // local state / -1: no transition
+} hsmCell_t;
+
+// Event set used by a state machine
+typedef struct
+{
+    int16_t eventSetID;
+    int16_t smIndex;        // smDataArray index
+    int16_t event;          // local event
+    bool loadsOFF;          // "State Machines and Events" rule
+} hsmEventRow_t;
+
+// Event set: smEventRows[start..start+count-1] (sorted by state machine)
+// (smEventIndex index: eventSetID * HARPISM_SHARD_COUNT + shard)
+typedef struct
+{
+    int16_t count;
+    int32_t start;
+} hsmEventIndex_t;
+
+// Compiler: "States and Actions" / "State Transitions" row of a machine
+typedef struct
+{
+    int16_t state;          // local state
+    int16_t event;          // local event
+    int16_t nextState;      // local state (transitions) / -1 (actions)
+    int16_t actionsSetID;
+    int32_t order;          // actions first, then transitions (array order)
+} hsmCompileRow_t;
+
+// Compiler: work arrays (sized for all the rows)
+typedef struct
+{
+    int16_t* events;        // local event -> event set ID
+    bool* loadsOFF;         // local event -> "State Machines and Events"
+    int16_t* states;        // local state -> state ID
+    hsmCompileRow_t* rows;
+} hsmCompileTemp_t;
+
+// Output request (sent after unlocking)
+typedef enum
+{
+    HARPISM_REQUEST_ACTIONS = 0,    // id: actionsSetID
+    HARPISM_REQUEST_LOADS_OFF       // id: stateMachineID
+} hsmRequestType_t;
+
+typedef struct
+{
+    hsmRequestType_t type;
+    int16_t id;
+} hsmRequest_t;
+
+/* Output of a dispatch: the actions and loads OFF of the state machines are
+ * collected while the state machines are locked, and sent in order after 
+ * unlocking (flushOutput) - no actions / loads / CAN locks inside. All of 
+ * them use the interactive write lane (kept in order).
+ */
+typedef struct
+{
+    hsmRequest_t local[HARPISM_OUTPUT_SIZE];
+    hsmRequest_t* requests;     // local / allocated (more requests)
+    int32_t count;
+    int32_t size;
+} hsmOutput_t;
+
 //----------------------------------------------------------------------------//
 // INTERNAL GLOBAL VARIABLES
 //----------------------------------------------------------------------------//
@@ -49,17 +187,69 @@ static harpiStateActionsData* harpiSActionsArray = NULL;
 static int16_t harpiSActionsArrayLen = 0;
 static harpiStateTransitionsData* harpiSTransitionArray = NULL;
 static int16_t harpiSTransitionArrayLen = 0;
-static int16_t* smIDArray;
-static int16_t smIDArrayLen;
+static harpiStateTimeoutsData* harpiSTimeoutsArray = NULL;
+static int16_t harpiSTimeoutsArrayLen = 0;
 static hsmData_t* smDataArray;
 static int16_t smDataArrayLen;
+// Compiled state machines (built on load)
+static int16_t* smStates = NULL;
+static int32_t smStatesLen = 0;
+static uint32_t* smTimeouts = NULL;    // ms - per local state (as smStates)
+static hsmCell_t* smCells = NULL;
+static int32_t smCellsLen = 0;
+static int16_t* smActions = NULL;
+static int32_t smActionsLen = 0;
+static hsmEventRow_t* smEventRows = NULL;
+static int32_t smEventRowsLen = 0;
+static hsmEventIndex_t* smEventIndex = NULL;
+static int32_t smEventIndexLen = 0;
+#ifdef HARPISM_SHARDS
+/* Shards: the events are pushed under g_SM_mutex (single producer) and the 
+ * state machines of a shard are checked under its mutex (worker). Loading 
+ * takes g_SM_mutex and then all the shard mutexes. The producer never waits
+ * for a worker: events not fitting in a full buffer are dropped and counted
+ * (g_shardDropped, under g_SM_mutex).
+ */
+static pthread_mutex_t g_Shard_mutex[HARPISM_SHARDS] = {
+    [0 ... HARPISM_SHARDS - 1] = PTHREAD_MUTEX_INITIALIZER};
+static pthread_t g_shardThread[HARPISM_SHARDS];
+static int g_shardBufferID[HARPISM_SHARDS] = {[0 ... HARPISM_SHARDS - 1] = -1};
+static int g_shardEventFD[HARPISM_SHARDS] = {[0 ... HARPISM_SHARDS - 1] = -1};
+static bool g_shardRunning[HARPISM_SHARDS];
+static uint32_t g_shardDropped[HARPISM_SHARDS];
+#endif
 
 //----------------------------------------------------------------------------//
 // INTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
 static bool copyListToArray(harpiLinkedList* element);
 static void initStateMachinesArrays(void);
-static void checkSMs(harpiEvent_t* event);
+static int16_t getLocalIndex(int16_t* ids, int16_t* len, int16_t id);
+static int compareCompileRows(const void* a, const void* b);
+static int compareCells(const void* a, const void* b);
+static int compareEventRows(const void* a, const void* b);
+static void freeCompiled(void);
+static bool compileStateMachine(int16_t i_SM, hsmCompileTemp_t* temp);
+static void compileStateMachines(void);
+static void compileTimeouts(hsmData_t* sm);
+static hsmEventRow_t* lookupEventIndex(int16_t eventSetID, int16_t shard, 
+        int16_t* count);
+static hsmCell_t* getCell(hsmData_t* sm, int16_t event);
+static void initOutput(hsmOutput_t* output);
+static void addOutput(hsmOutput_t* output, hsmRequestType_t type, int16_t id);
+static void flushOutput(hsmOutput_t* output);
+static void checkSMs(harpiEvent_t* event, int16_t shard, 
+        hsmOutput_t* output);
+static void timerExpired(int16_t stateMachineID, uint32_t sequence);
+static void lockShards(void);
+static void unlockShards(void);
+#ifdef HARPISM_SHARDS
+static void dispatchEvents(harpiEvent_t* events, int count, 
+        hsmOutput_t* output);
+static void pushShard(int16_t shard, harpiEvent_t* events, int count, 
+        hsmOutput_t* output);
+static void* shardWorker(void* arg);
+#endif
 
 // Copy from the Linked List to the Array - return true if OK
 static bool copyListToArray(harpiLinkedList* element)
@@ -67,12 +257,14 @@ static bool copyListToArray(harpiLinkedList* element)
     int16_t i_events;
     int16_t i_actions;
     int16_t i_transitions;
+    int16_t i_timeouts;
     bool isOK;
     harpiLinkedList* current;
     // Check all
     i_events = 0;
     i_actions = 0;
     i_transitions = 0;
+    i_timeouts = 0;
     isOK = true;
     if(element != NULL)
     {
@@ -122,7 +314,7 @@ static bool copyListToArray(harpiLinkedList* element)
                 //    - State Transitions
                 // ----------------------------------
                 case CSV_SECTION_STATE_TRANSITIONS:
-                    if(i_transitions >= harpiSActionsArrayLen)
+                    if(i_transitions >= harpiSTransitionArrayLen)
                     {
                         #ifdef DEBUG_HARPISM_ERRORS
                         debug_print("harpism_load error: Transitions!\n");
@@ -138,6 +330,25 @@ static bool copyListToArray(harpiLinkedList* element)
                     }
                     break;
                 // ----------------------------------
+                //    - State Timeouts
+                // ----------------------------------
+                case CSV_SECTION_STATE_TIMEOUTS:
+                    if(i_timeouts >= harpiSTimeoutsArrayLen)
+                    {
+                        #ifdef DEBUG_HARPISM_ERRORS
+                        debug_print("harpism_load error: Timeouts!\n");
+                        #endif
+                        isOK = false;
+                    }
+                    else
+                    {
+                        memcpy(&(harpiSTimeoutsArray[i_timeouts]),
+                            &(current->stateTimeoutsData), 
+                            sizeof(harpiStateTimeoutsData));
+                        i_timeouts++;
+                    }
+                    break;
+                // ----------------------------------
                 //    - Others: do nothing
                 // ----------------------------------
                 default:
@@ -153,231 +364,851 @@ static bool copyListToArray(harpiLinkedList* element)
 }
 
 // From the State Machine arrays, create the state machine status and 
-// initialize it
+// initialize it (one per stateMachineID)
 static void initStateMachinesArrays(void)
 {
-    int16_t i_Array;
     int16_t i_SM;
-    int16_t* tempArray = NULL;
-    int16_t tempArrayLen = 0;
-    int16_t smcount;
-    int16_t totalLen;
-    bool ignoreID;
     // Init arrays
-    if(smIDArray != NULL)
-    {
-        free(smIDArray);
-        smIDArray = NULL;
-    }
     if(smDataArray != NULL)
     {
         free(smDataArray);
+        smDataArray = NULL;
     }
-    smIDArrayLen = 0;
     smDataArrayLen = 0;
-    // Init
-    smcount = 0;
-    totalLen = harpiSMEventsArrayLen + harpiSActionsArrayLen + 
-        harpiSTransitionArrayLen;
-    // Update if arrays exist and are OK
-    if(totalLen > 0)
+    // One per state machine ID (0..N-1)
+    smDataArrayLen = harpi_getIDCount(HARPI_ID_STATE_MACHINE);
+    if(smDataArrayLen > 0)
     {
-        // Init Temp Array
-        tempArray = (int16_t*)malloc(totalLen * sizeof(int16_t));
-        tempArrayLen = totalLen;
-        // Init entire array
-        for(i_SM = 0; i_SM < tempArrayLen; i_SM++)
+        smDataArray = (hsmData_t*)malloc(smDataArrayLen * sizeof(hsmData_t));
+        if(smDataArray == NULL)
         {
-            tempArray[i_SM] = -1;
+            #ifdef DEBUG_HARPISM_ERRORS
+            debug_print("harpism_load error: State machines memory!\n");
+            #endif
+            smDataArrayLen = 0;
+            return;
         }
-        // Init first position
-        if(harpiSMEventsArrayLen > 0)
+        for(i_SM = 0; i_SM < smDataArrayLen; i_SM++)
         {
-            tempArray[0] = harpiSMEventsArray[0].stateMachineID;
+            // Init with state 0 (tables compiled later)
+            memset(&smDataArray[i_SM], 0, sizeof(hsmData_t));
+            smDataArray[i_SM].stateMachineID = i_SM;
+            smDataArray[i_SM].timerStatus = HARPI_TIMER_INIT;
         }
-        else if(harpiSActionsArrayLen > 0)
+    }
+}
+
+// Get the local index of an ID (added if new)
+static int16_t getLocalIndex(int16_t* ids, int16_t* len, int16_t id)
+{
+    int16_t i;
+    for(i = 0; i < *len; i++)
+    {
+        if(ids[i] == id)
         {
-            tempArray[0] = harpiSActionsArray[0].stateMachineID;
+            return i;
         }
-        else if(harpiSTransitionArrayLen > 0)  
+    }
+    ids[*len] = id;
+    (*len)++;
+    return i;
+}
+
+// Sort compiler rows: by state, event and order
+static int compareCompileRows(const void* a, const void* b)
+{
+    const hsmCompileRow_t* ra = a;
+    const hsmCompileRow_t* rb = b;
+    if(ra->state != rb->state)
+    {
+        return (int)ra->state - (int)rb->state;
+    }
+    if(ra->event != rb->event)
+    {
+        return (int)ra->event - (int)rb->event;
+    }
+    return (ra->order < rb->order) ? -1 : (ra->order > rb->order);
+}
+
+// Compare cells (sparse tables - bsearch)
+static int compareCells(const void* a, const void* b)
+{
+    const hsmCell_t* ca = a;
+    const hsmCell_t* cb = b;
+    return (ca->key < cb->key) ? -1 : (ca->key > cb->key);
+}
+
+// Sort event rows: by event set, shard, then state machine (checkSMs order)
+static int compareEventRows(const void* a, const void* b)
+{
+    const hsmEventRow_t* ra = a;
+    const hsmEventRow_t* rb = b;
+    if(ra->eventSetID != rb->eventSetID)
+    {
+        return (int)ra->eventSetID - (int)rb->eventSetID;
+    }
+    if( (ra->smIndex % HARPISM_SHARD_COUNT) != 
+        (rb->smIndex % HARPISM_SHARD_COUNT) )
+    {
+        return (int)(ra->smIndex % HARPISM_SHARD_COUNT) - 
+            (int)(rb->smIndex % HARPISM_SHARD_COUNT);
+    }
+    return (int)ra->smIndex - (int)rb->smIndex;
+}
+
+// Free the compiled state machines (under g_SM_mutex)
+static void freeCompiled(void)
+{
+    free(smStates);
+    smStates = NULL;
+    smStatesLen = 0;
+    free(smTimeouts);
+    smTimeouts = NULL;
+    free(smCells);
+    smCells = NULL;
+    smCellsLen = 0;
+    free(smActions);
+    smActions = NULL;
+    smActionsLen = 0;
+    free(smEventRows);
+    smEventRows = NULL;
+    smEventRowsLen = 0;
+    free(smEventIndex);
+    smEventIndex = NULL;
+    smEventIndexLen = 0;
+}
+
+/* Compile one state machine: state IDs and event set IDs are remapped to 
+ * local indexes and the rows are merged into [state][event] cells (actions
+ * in array order, the last transition wins - as checked by the old lists).
+ */
+static bool compileStateMachine(int16_t i_SM, hsmCompileTemp_t* temp)
+{
+    int32_t i;
+    int32_t j;
+    int32_t nRows;
+    int32_t cells;
+    int32_t sparse;
+    int32_t next;
+    int16_t before;
+    int16_t e;
+    int16_t nEvents;
+    int16_t nStates;
+    int16_t stateMachineID;
+    hsmCell_t* cell;
+    hsmCell_t* newCells;
+    hsmData_t* sm;
+    sm = &smDataArray[i_SM];
+    stateMachineID = sm->stateMachineID;
+    nEvents = 0;
+    nStates = 0;
+    nRows = 0;
+    // State ID 0 (initial state) is always local state 0
+    getLocalIndex(temp->states, &nStates, 0);
+    //----------------------------------------
+    // Local events and states
+    //----------------------------------------
+    for(i = 0; i < harpiSMEventsArrayLen; i++)
+    {
+        if(harpiSMEventsArray[i].stateMachineID == stateMachineID)
         {
-            tempArray[0] = harpiSTransitionArray[0].stateMachineID;
+            e = getLocalIndex(temp->events, &nEvents, 
+                harpiSMEventsArray[i].eventSetID);
+            temp->loadsOFF[e] = true;
         }
-        smcount++;
-        // Check the harpiSMEventsData array
-        for(i_Array = 0; i_Array < harpiSMEventsArrayLen; i_Array++)
+    }
+    for(i = 0; i < harpiSActionsArrayLen; i++)
+    {
+        if(harpiSActionsArray[i].stateMachineID == stateMachineID)
         {
-            ignoreID = false;
-            for(i_SM = 0; i_SM < smcount; i_SM++)
+            before = nEvents;
+            e = getLocalIndex(temp->events, &nEvents, 
+                harpiSActionsArray[i].eventSetID);
+            if(nEvents != before)
             {
-                if(harpiSMEventsArray[i_Array].stateMachineID == 
-                    tempArray[i_SM])
-                {
-                    ignoreID = true;
-                }
-            }
-            if(!ignoreID)
-            {
-                // Add to the list of states
-                tempArray[smcount] = harpiSMEventsArray[i_Array].stateMachineID;
-                smcount++;
+                temp->loadsOFF[e] = false;
             }
+            temp->rows[nRows].state = getLocalIndex(temp->states, &nStates, 
+                harpiSActionsArray[i].currentStateID);
+            temp->rows[nRows].event = e;
+            temp->rows[nRows].nextState = -1;
+            temp->rows[nRows].actionsSetID = harpiSActionsArray[i].actionsSetID;
+            temp->rows[nRows].order = i;
+            nRows++;
         }
-        // Check the harpiStateActionsData array
-        for(i_Array = 0; i_Array < harpiSActionsArrayLen; i_Array++)
+    }
+    for(i = 0; i < harpiSTransitionArrayLen; i++)
+    {
+        if(harpiSTransitionArray[i].stateMachineID == stateMachineID)
         {
-            ignoreID = false;
-            for(i_SM = 0; i_SM < smcount; i_SM++)
+            before = nEvents;
+            e = getLocalIndex(temp->events, &nEvents, 
+                harpiSTransitionArray[i].eventSetID);
+            if(nEvents != before)
             {
-                if(harpiSActionsArray[i_Array].stateMachineID == 
-                    tempArray[i_SM])
-                {
-                    ignoreID = true;
-                }
+                temp->loadsOFF[e] = false;
             }
-            if(!ignoreID)
+            temp->rows[nRows].state = getLocalIndex(temp->states, &nStates, 
+                harpiSTransitionArray[i].currentStateID);
+            temp->rows[nRows].event = e;
+            temp->rows[nRows].nextState = getLocalIndex(temp->states, 
+                &nStates, harpiSTransitionArray[i].newStateID);
+            temp->rows[nRows].actionsSetID = 0;
+            temp->rows[nRows].order = (int32_t)harpiSActionsArrayLen + i;
+            nRows++;
+        }
+    }
+    qsort(temp->rows, nRows, sizeof(hsmCompileRow_t), compareCompileRows);
+    //----------------------------------------
+    // Cells: dense [state][event] table if small enough, else sorted
+    //----------------------------------------
+    sparse = 0;
+    for(i = 0; i < nRows; i++)
+    {
+        if( (i == 0) || (temp->rows[i].state != temp->rows[i - 1].state) || 
+            (temp->rows[i].event != temp->rows[i - 1].event) )
+        {
+            sparse++;
+        }
+    }
+    cells = (int32_t)nStates * nEvents;
+    sm->dense = (cells <= HARPISM_DENSE_MAX_CELLS);
+    if(!sm->dense)
+    {
+        cells = sparse;
+    }
+    newCells = (hsmCell_t*)realloc(smCells, (smCellsLen + cells + 1) * 
+        sizeof(hsmCell_t));
+    if(newCells == NULL)
+    {
+        return false;
+    }
+    smCells = newCells;
+    sm->cellStart = smCellsLen;
+    sm->cellCount = cells;
+    if(sm->dense)
+    {
+        for(i = 0; i < cells; i++)
+        {
+            smCells[smCellsLen + i].key = i;
+            smCells[smCellsLen + i].actionStart = smActionsLen;
+            smCells[smCellsLen + i].actionCount = 0;
+            smCells[smCellsLen + i].nextState = -1;
+        }
+    }
+    cell = NULL;
+    next = 0;
+    for(i = 0; i < nRows; i++)
+    {
+        if( (i == 0) || (temp->rows[i].state != temp->rows[i - 1].state) || 
+            (temp->rows[i].event != temp->rows[i - 1].event) )
+        {
+            // New cell
+            j = (int32_t)temp->rows[i].state * nEvents + temp->rows[i].event;
+            cell = sm->dense ? &smCells[smCellsLen + j] : 
+                &smCells[smCellsLen + next++];
+            cell->key = j;
+            cell->actionStart = smActionsLen;
+            cell->actionCount = 0;
+            cell->nextState = -1;
+        }
+        if(temp->rows[i].nextState < 0)
+        {
+            smActions[smActionsLen++] = temp->rows[i].actionsSetID;
+            cell->actionCount++;
+        }
+        else
+        {
+            // Last transition wins
+            cell->nextState = temp->rows[i].nextState;
+        }
+    }
+    smCellsLen += sm->cellCount;
+    //----------------------------------------
+    // Local states (reverse map) and event sets used
+    //----------------------------------------
+    sm->stateStart = smStatesLen;
+    sm->states = nStates;
+    sm->events = nEvents;
+    sm->currentState = 0;
+    memcpy(&smStates[smStatesLen], temp->states, nStates * sizeof(int16_t));
+    smStatesLen += nStates;
+    compileTimeouts(sm);
+    for(e = 0; e < nEvents; e++)
+    {
+        smEventRows[smEventRowsLen].eventSetID = temp->events[e];
+        smEventRows[smEventRowsLen].smIndex = i_SM;
+        smEventRows[smEventRowsLen].event = e;
+        smEventRows[smEventRowsLen].loadsOFF = temp->loadsOFF[e];
+        smEventRowsLen++;
+    }
+    return true;
+}
+
+// Compile all the state machines and index them by event set (under 
+// g_SM_mutex, after initStateMachinesArrays)
+static void compileStateMachines(void)
+{
+    int32_t i;
+    int32_t totalLen;
+    int32_t key;
+    int16_t eventSetID;
+    bool isOK;
+    hsmCompileTemp_t temp;
+    // Clear previous data
+    freeCompiled();
+    totalLen = (int32_t)harpiSMEventsArrayLen + harpiSActionsArrayLen + 
+        harpiSTransitionArrayLen;
+    if( (totalLen <= 0) || (smDataArrayLen <= 0) )
+    {
+        return;
+    }
+    //----------------------------------------
+    // Memory: sized for all the rows
+    //----------------------------------------
+    temp.events = (int16_t*)malloc(totalLen * sizeof(int16_t));
+    temp.loadsOFF = (bool*)malloc(totalLen * sizeof(bool));
+    temp.states = (int16_t*)malloc((2 * totalLen + 1) * sizeof(int16_t));
+    temp.rows = (hsmCompileRow_t*)malloc(totalLen * sizeof(hsmCompileRow_t));
+    smStates = (int16_t*)malloc((2 * totalLen + smDataArrayLen) * 
+        sizeof(int16_t));
+    smTimeouts = (uint32_t*)malloc((2 * totalLen + smDataArrayLen) * 
+        sizeof(uint32_t));
+    smActions = (int16_t*)malloc(totalLen * sizeof(int16_t));
+    smEventRows = (hsmEventRow_t*)malloc(totalLen * sizeof(hsmEventRow_t));
+    smEventIndexLen = (int32_t)harpi_getIDCount(HARPI_ID_EVENT_SET) * 
+        HARPISM_SHARD_COUNT;
+    smEventIndex = (hsmEventIndex_t*)calloc(smEventIndexLen + 1, 
+        sizeof(hsmEventIndex_t));
+    isOK = (temp.events != NULL) && (temp.loadsOFF != NULL) && 
+        (temp.states != NULL) && (temp.rows != NULL) && (smStates != NULL) && 
+        (smTimeouts != NULL) && (smActions != NULL) && (smEventRows != NULL) && 
+        (smEventIndex != NULL);
+    //----------------------------------------
+    // State machines
+    //----------------------------------------
+    for(i = 0; isOK && (i < smDataArrayLen); i++)
+    {
+        isOK = compileStateMachine(i, &temp);
+    }
+    free(temp.events);
+    free(temp.loadsOFF);
+    free(temp.states);
+    free(temp.rows);
+    if(!isOK)
+    {
+        #ifdef DEBUG_HARPISM_ERRORS
+        debug_print("harpism_load error: Compiler memory!\n");
+        #endif
+        freeCompiled();
+        return;
+    }
+    //----------------------------------------
+    // Event sets (per shard): first row and number of rows
+    //----------------------------------------
+    qsort(smEventRows, smEventRowsLen, sizeof(hsmEventRow_t), 
+        compareEventRows);
+    for(i = 0; i < smEventRowsLen; i++)
+    {
+        eventSetID = smEventRows[i].eventSetID;
+        key = (int32_t)eventSetID * HARPISM_SHARD_COUNT + 
+            smEventRows[i].smIndex % HARPISM_SHARD_COUNT;
+        if( (eventSetID < 0) || (key >= smEventIndexLen) )
+        {
+            // Event set not defined - never generated
+            continue;
+        }
+        if(smEventIndex[key].count == 0)
+        {
+            smEventIndex[key].start = i;
+        }
+        smEventIndex[key].count++;
+    }
+}
+
+/* Timeout of each local state of a state machine (after its states): 
+ * HARPI_STATE_WAIT_PERIOD, then the "State Timeouts" of the state machine 
+ * ("*"), then the ones of each state (the last one wins)
+ */
+static void compileTimeouts(hsmData_t* sm)
+{
+    int16_t i;
+    int16_t state;
+    harpiStateTimeoutsData* row;
+    for(state = 0; state < sm->states; state++)
+    {
+        smTimeouts[sm->stateStart + state] = HARPI_STATE_WAIT_PERIOD;
+    }
+    for(i = 0; i < harpiSTimeoutsArrayLen; i++)
+    {
+        row = &harpiSTimeoutsArray[i];
+        if( (row->stateMachineID == sm->stateMachineID) && (row->stateID < 0) )
+        {
+            for(state = 0; state < sm->states; state++)
             {
-                // Add to the list of states
-                tempArray[smcount] = harpiSActionsArray[i_Array].stateMachineID;
-                smcount++;
+                smTimeouts[sm->stateStart + state] = (uint32_t)row->timeout;
             }
         }
-        // Check the harpiStateTransitionsData array
-        for(i_Array = 0; i_Array < harpiSTransitionArrayLen; i_Array++)
+    }
+    for(i = 0; i < harpiSTimeoutsArrayLen; i++)
+    {
+        row = &harpiSTimeoutsArray[i];
+        if( (row->stateMachineID != sm->stateMachineID) || (row->stateID < 0) )
         {
-            ignoreID = false;
-            for(i_SM = 0; i_SM < smcount; i_SM++)
+            continue;
+        }
+        // Local state (states not used by the state machine are ignored)
+        for(state = 0; state < sm->states; state++)
+        {
+            if(smStates[sm->stateStart + state] == row->stateID)
             {
-                if(harpiSTransitionArray[i_Array].stateMachineID == 
-                    tempArray[i_SM])
-                {
-                    ignoreID = true;
-                }
+                smTimeouts[sm->stateStart + state] = (uint32_t)row->timeout;
+                break;
             }
-            if(!ignoreID)
+        }
+    }
+}
+
+// Get the state machines of a shard using an event set (NULL if none)
+static hsmEventRow_t* lookupEventIndex(int16_t eventSetID, int16_t shard, 
+        int16_t* count)
+{
+    int32_t key;
+    *count = 0;
+    key = (int32_t)eventSetID * HARPISM_SHARD_COUNT + shard;
+    if( (eventSetID < 0) || (key >= smEventIndexLen) || 
+        (smEventIndex[key].count == 0) )
+    {
+        return NULL;
+    }
+    *count = smEventIndex[key].count;
+    return &smEventRows[smEventIndex[key].start];
+}
+
+// Get the cell of the current state and a local event (NULL if none)
+static hsmCell_t* getCell(hsmData_t* sm, int16_t event)
+{
+    hsmCell_t key;
+    key.key = (int32_t)sm->currentState * sm->events + event;
+    if(sm->dense)
+    {
+        return &smCells[sm->cellStart + key.key];
+    }
+    return (hsmCell_t*)bsearch(&key, &smCells[sm->cellStart], sm->cellCount, 
+        sizeof(hsmCell_t), compareCells);
+}
+
+// Init the output of a dispatch
+static void initOutput(hsmOutput_t* output)
+{
+    output->requests = output->local;
+    output->count = 0;
+    output->size = HARPISM_OUTPUT_SIZE;
+}
+
+// Add a request to the output (in order)
+static void addOutput(hsmOutput_t* output, hsmRequestType_t type, int16_t id)
+{
+    hsmRequest_t* requests;
+    if(output->count >= output->size)
+    {
+        // More requests - double the size
+        requests = (hsmRequest_t*)malloc(2 * output->size * 
+            sizeof(hsmRequest_t));
+        if(requests == NULL)
+        {
+            #ifdef DEBUG_HARPISM_ERRORS
+            debug_print("harpism - ERROR: output memory!\n");
+            #endif
+            return;
+        }
+        memcpy(requests, output->requests, output->count * 
+            sizeof(hsmRequest_t));
+        if(output->requests != output->local)
+        {
+            free(output->requests);
+        }
+        output->requests = requests;
+        output->size = 2 * output->size;
+    }
+    output->requests[output->count].type = type;
+    output->requests[output->count].id = id;
+    output->count++;
+}
+
+// Send the output of a dispatch (NOT locked): frames (already encoded) added 
+// to the CAN write buffer in batches
+static void flushOutput(hsmOutput_t* output)
+{
+    struct can_frame frames[HARPISM_OUTPUT_FRAMES];
+    unsigned long long millisecondsSinceEpoch;
+    int32_t i;
+    int count;
+    int check;
+    millisecondsSinceEpoch = aux_getmsSinceEpoch();
+    count = 0;
+    for(i = 0; i <= output->count; i++)
+    {
+        // Send when there may be no room for the next request (or at the end)
+        if( (count > 0) && ( (i == output->count) || 
+            (count > HARPISM_OUTPUT_FRAMES - MAXIMUM_ACTIONS) ) )
+        {
+            check = hapcan_addCANFramesToWriteBuffer(frames, count, 
+                CAN_LANE_INTERACTIVE, millisecondsSinceEpoch);
+            if(check != HAPCAN_CAN_RESPONSE)
             {
-                // Add to the list of states
-                tempArray[smcount] = 
-                    harpiSTransitionArray[i_Array].stateMachineID;
-                smcount++;
+                #ifdef DEBUG_HARPISM_ERRORS
+                debug_print("harpism - ERROR: CAN write!\n");
+                #endif
             }
+            count = 0;
         }
-        // Copy from temporary array to final array
-        smIDArrayLen = smcount;
-        smDataArrayLen = smcount;
-        smIDArray = (int16_t*)malloc(smIDArrayLen * sizeof(int16_t));
-        smDataArray = (hsmData_t*)malloc(smDataArrayLen * sizeof(hsmData_t));
-        for(i_SM = 0; i_SM < smcount; i_SM++)
+        if(i == output->count)
+        {
+            break;
+        }
+        if(output->requests[i].type == HARPISM_REQUEST_ACTIONS)
+        {
+            count += harpiactions_getActionsFromID(output->requests[i].id, 
+                &frames[count], MAXIMUM_ACTIONS);
+        }
+        else
         {
-            smIDArray[i_SM] = tempArray[i_SM];
-            smDataArray[i_SM].stateMachineID = tempArray[i_SM];
-            // Init with state 0
-            smDataArray[i_SM].currentStateID = 0;
+            count += harpiloads_getLoadsOFF(output->requests[i].id, 
+                &frames[count], MAXIMUM_ACTIONS);
         }
-        // Free temporary array
-        free(tempArray);
-        tempArray = NULL;
     }
+    // Clear
+    if(output->requests != output->local)
+    {
+        free(output->requests);
+    }
+    initOutput(output);
 }
 
-// Check a new event for the state machines
-static void checkSMs(harpiEvent_t* event)
+// Check a new event for the state machines of a shard (only the ones using 
+// the event). The actions and loads OFF are added to the output
+static void checkSMs(harpiEvent_t* event, int16_t shard, hsmOutput_t* output)
 {
-    int16_t i_SM;
     int16_t i;
-    int16_t stateMachineID;
-    int16_t currentStateID;
+    int16_t count;
+    int32_t i_Action;
     bool match;
-    bool skip;
+    hsmData_t* sm;
+    hsmCell_t* cell;
+    hsmEventRow_t* rows;
     harpiLoadStatus_t load_status;
-    harpiTimerStatus_t timer_status;
-    // Check all state machines
-    for(i_SM = 0; i_SM < smDataArrayLen; i_SM++)
+    // State machines using the event
+    rows = lookupEventIndex(event->eventSetID, shard, &count);
+    for(i = 0; i < count; i++)
     {
-        // Update information for the current state machine
-        stateMachineID = smDataArray[i_SM].stateMachineID;
-        currentStateID = smDataArray[i_SM].currentStateID;
+        sm = &smDataArray[rows[i].smIndex];
         //---------------------------------------------
         // State Machines and Events
         //---------------------------------------------
-        skip = false;
-        for(i = 0; i < harpiSMEventsArrayLen; i++)
-        {
-            match = (!skip);
-            match = match && (harpiSMEventsArray[i].stateMachineID == 
-                stateMachineID);
-            match = match && (harpiSMEventsArray[i].eventSetID == 
-                event->eventSetID);
+        if(rows[i].loadsOFF)
+        {
+            // Check timer - if it is expired or was never started 
+            // (timerExpired)
+            match = (sm->timerStatus != HARPI_TIMER_RUNNING);
+            // Check loads status
+            load_status = harpiloads_isAnyLoadON(sm->stateMachineID);
+            match = match && (load_status == HARPI_LOAD_STATUS_ON);
             if(match)
             {
-                // Check timer - if it is expired or exists
-                timer_status = timer_getTimerStatus(stateMachineID);
-                match = (timer_status == HARPI_TIMER_EXPIRED);
-                match = match || (timer_status == HARPI_TIMER_INIT);
-                // Check loads status
-                load_status = harpiloads_isAnyLoadON(stateMachineID);
-                match = match && (load_status == HARPI_LOAD_STATUS_ON);
-                if(match)
-                {
-                    // Turn Off the loads
-                    harpiloads_setLoadsOFF(stateMachineID);
-                    // Set to initial state
-                    smDataArray[i_SM].currentStateID = 0;
-                    // Skip "States and Actions" and "State Transitions"
-                    skip = true;
-                }
+                // Turn Off the loads
+                addOutput(output, HARPISM_REQUEST_LOADS_OFF, 
+                    sm->stateMachineID);
+                // Set to initial state
+                sm->currentState = 0;
+                // Skip "States and Actions" and "State Transitions"
+                continue;
             }
         }
+        // One lookup: [current state][event]
+        cell = getCell(sm, rows[i].event);
+        if(cell == NULL)
+        {
+            continue;
+        }
         //---------------------------------------------
         // States and Actions
         //---------------------------------------------
-        if(!skip)
+        for(i_Action = cell->actionStart; 
+            i_Action < cell->actionStart + cell->actionCount; i_Action++)
         {
-            for(i = 0; i < harpiSActionsArrayLen; i++)
-            {
-                match = (harpiSActionsArray[i].stateMachineID == 
-                    stateMachineID);
-                match = match && (harpiSActionsArray[i].eventSetID == 
-                    event->eventSetID);
-                match = match && (harpiSActionsArray[i].currentStateID == 
-                    currentStateID);
-                if(match)
-                {
-                    // New event: Start timer
-                    timer_setTimer(stateMachineID, HARPI_STATE_WAIT_PERIOD);
-                    // Perform the Action
-                    harpiactions_SendActionsFromID(
-                        harpiSActionsArray[i].actionsSetID);
-                }
-            }
+            // Perform the Action
+            addOutput(output, HARPISM_REQUEST_ACTIONS, smActions[i_Action]);
         }
         //---------------------------------------------
         // State Transitions
         //---------------------------------------------
-        if(!skip)
+        if(cell->nextState >= 0)
+        {
+            sm->currentState = cell->nextState;
+        }
+        // New event with actions: (re)start timer - timeout of the new state
+        if(cell->actionCount > 0)
+        {
+            sm->timerSequence = timer_setTimer(sm->stateMachineID, 
+                smTimeouts[sm->stateStart + sm->currentState]);
+            if(sm->timerSequence != 0)
+            {
+                sm->timerStatus = HARPI_TIMER_RUNNING;
+            }
+        }
+    }
+}
+
+/* Timer of a state machine expired (timer_periodic - timers NOT locked): 
+ * ignored if the timer was restarted or the state machines were reloaded
+ */
+static void timerExpired(int16_t stateMachineID, uint32_t sequence)
+{
+    pthread_mutex_t* mutex;
+    hsmData_t* sm;
+    if(stateMachineID < 0)
+    {
+        return;
+    }
+    // Lock used by checkSMs for the state machine
+    #ifdef HARPISM_SHARDS
+    mutex = &g_Shard_mutex[stateMachineID % HARPISM_SHARDS];
+    #else
+    mutex = &g_SM_mutex;
+    #endif
+    // LOCK
+    pthread_mutex_lock(mutex);
+    if( (stateMachineID >= 0) && (stateMachineID < smDataArrayLen) )
+    {
+        sm = &smDataArray[stateMachineID];
+        if(sm->timerSequence == sequence)
+        {
+            sm->timerStatus = HARPI_TIMER_EXPIRED;
+        }
+    }
+    // UNLOCK
+    pthread_mutex_unlock(mutex);
+}
+
+// Lock all the shards (loading - under g_SM_mutex). The pending events are 
+// discarded (IDs of the previous configuration)
+static void lockShards(void)
+{
+    #ifdef HARPISM_SHARDS
+    int16_t shard;
+    for(shard = 0; shard < HARPISM_SHARDS; shard++)
+    {
+        // LOCK
+        pthread_mutex_lock(&g_Shard_mutex[shard]);
+        if(g_shardBufferID[shard] >= 0)
+        {
+            spscbuf_clean(g_shardBufferID[shard]);
+        }
+    }
+    #endif
+}
+
+// Unlock all the shards
+static void unlockShards(void)
+{
+    #ifdef HARPISM_SHARDS
+    int16_t shard;
+    for(shard = HARPISM_SHARDS - 1; shard >= 0; shard--)
+    {
+        // UNLOCK
+        pthread_mutex_unlock(&g_Shard_mutex[shard]);
+    }
+    #endif
+}
+
+#ifdef HARPISM_SHARDS
+// Hand the events to the shards using them (under g_SM_mutex - producer)
+static void dispatchEvents(harpiEvent_t* events, int count, 
+        hsmOutput_t* output)
+{
+    harpiEvent_t batch[HARPISM_SHARD_BATCH];
+    int16_t shard;
+    int16_t rows;
+    int i;
+    int n;
+    for(shard = 0; shard < HARPISM_SHARDS; shard++)
+    {
+        n = 0;
+        for(i = 0; i < count; i++)
         {
-            for(i = 0; i < harpiSTransitionArrayLen; i++)
+            // Only the events used by the state machines of the shard
+            if(lookupEventIndex(events[i].eventSetID, shard, &rows) == NULL)
             {
-                match = (harpiSTransitionArray[i].stateMachineID == 
-                    stateMachineID);
-                match = match && (harpiSTransitionArray[i].eventSetID == 
-                    event->eventSetID);
-                match = match && (harpiSTransitionArray[i].currentStateID == 
-                    currentStateID);
-                if(match)
-                {
-                    // State transition
-                    smDataArray[i_SM].currentStateID = 
-                        harpiSTransitionArray[i].newStateID;
-                }
+                continue;
+            }
+            batch[n] = events[i];
+            n++;
+            if(n == HARPISM_SHARD_BATCH)
+            {
+                pushShard(shard, batch, n, output);
+                n = 0;
             }
         }
+        pushShard(shard, batch, n, output);
     }
 }
 
+// Push events to a shard (drops the events not fitting in a full buffer). 
+// Without worker the state machines of the shard are checked right away
+static void pushShard(int16_t shard, harpiEvent_t* events, int count, 
+        hsmOutput_t* output)
+{
+    int i;
+    int pushed;
+    if(!g_shardRunning[shard])
+    {
+        // LOCK
+        pthread_mutex_lock(&g_Shard_mutex[shard]);
+        for(i = 0; i < count; i++)
+        {
+            checkSMs(&events[i], shard, output);
+        }
+        // UNLOCK
+        pthread_mutex_unlock(&g_Shard_mutex[shard]);
+        return;
+    }
+    if(count <= 0)
+    {
+        return;
+    }
+    pushed = spscbuf_pushN(g_shardBufferID[shard], events, count);
+    if(pushed < 0)
+    {
+        #ifdef DEBUG_HARPISM_ERRORS
+        debug_print("harpism - ERROR: shard %d buffer!\n", shard);
+        #endif
+        pushed = 0;
+    }
+    if(pushed < count)
+    {
+        // Full - never wait for the worker under g_SM_mutex
+        g_shardDropped[shard] += (uint32_t)(count - pushed);
+        #ifdef DEBUG_HARPISM_ERRORS
+        debug_print("harpism - ERROR: shard %d full, %d events dropped!\n", 
+            shard, count - pushed);
+        #endif
+    }
+}
+
+/* THREAD - Check the state machines of a shard: the events are handled in 
+ * order, so the actions of each state machine are sent in order (the frames
+ * of all the shards are merged by the CAN write buffer).
+ */
+static void* shardWorker(void* arg)
+{
+    harpiEvent_t events[HARPISM_SHARD_BATCH];
+    hsmOutput_t output;
+    struct pollfd pfd;
+    uint64_t lull_count;
+    int16_t shard;
+    int count;
+    int i;
+    shard = (int16_t)(intptr_t)arg;
+    initOutput(&output);
+    while(1)
+    {
+        // LOCK
+        pthread_mutex_lock(&g_Shard_mutex[shard]);
+        count = spscbuf_peekN(g_shardBufferID[shard], events, 
+            HARPISM_SHARD_BATCH);
+        for(i = 0; i < count; i++)
+        {
+            checkSMs(&events[i], shard, &output);
+        }
+        if(count > 0)
+        {
+            spscbuf_discard(g_shardBufferID[shard], count);
+        }
+        // UNLOCK
+        pthread_mutex_unlock(&g_Shard_mutex[shard]);
+        if(count > 0)
+        {
+            // Send actions / loads OFF
+            flushOutput(&output);
+            continue;
+        }
+        // Sleep until new events
+        if(g_shardEventFD[shard] < 0)
+        {
+            usleep(HARPISM_SHARD_WAIT);
+            continue;
+        }
+        pfd.fd = g_shardEventFD[shard];
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if(poll(&pfd, 1, HARPISM_SHARD_POLL_TIMEOUT) > 0)
+        {
+            // Clear counter (non-blocking)
+            if(read(pfd.fd, &lull_count, sizeof(lull_count)) != 
+                sizeof(lull_count))
+            {
+                continue;
+            }
+        }
+    }
+    return NULL;
+}
+#endif
+
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
+int harpism_createShards(void)
+{
+    #ifdef HARPISM_SHARDS
+    int16_t shard;
+    int check;
+    bool isOK;
+    isOK = true;
+    for(shard = 0; shard < HARPISM_SHARDS; shard++)
+    {
+        if(g_shardRunning[shard])
+        {
+            continue;
+        }
+        // Events buffer
+        if(g_shardBufferID[shard] < 0)
+        {
+            check = spscbuf_init(HARPISM_SHARD_BUFFER_SIZE, 
+                sizeof(harpiEvent_t));
+            if(check < 0)
+            {
+                #ifdef DEBUG_HARPISM_ERRORS
+                debug_print("harpism_createShards ERROR - Buffer Error!\n");
+                debug_print("- Shard: %d / Error: %d\n", shard, check);
+                #endif
+                isOK = false;
+                continue;
+            }
+            g_shardBufferID[shard] = check;
+            g_shardEventFD[shard] = spscbuf_enableEvents(check);
+        }
+        // Worker
+        check = pthread_create(&g_shardThread[shard], NULL, shardWorker, 
+            (void*)(intptr_t)shard);
+        if(check)
+        {
+            #ifdef DEBUG_HARPISM_ERRORS
+            debug_print("harpism_createShards ERROR - Thread Error!\n");
+            debug_print("- Shard: %d\n", shard);
+            #endif
+            isOK = false;
+            continue;
+        }
+        g_shardRunning[shard] = true;
+    }
+    return isOK ? EXIT_SUCCESS : EXIT_FAILURE;
+    #else
+    return EXIT_SUCCESS;
+    #endif
+}
+
 void harpism_init(void)
 {
     //---------------------------------------------
@@ -413,6 +1244,21 @@ void harpism_init(void)
         harpiSTransitionArray = NULL;
     }
     harpiSTransitionArrayLen = 0;
+    //----------------------------------------
+    //    - State Timeouts
+    //----------------------------------------
+    if(harpiSTimeoutsArray != NULL)
+    {
+        free(harpiSTimeoutsArray);
+        harpiSTimeoutsArray = NULL;
+    }
+    harpiSTimeoutsArrayLen = 0;
+    //----------------------------------------
+    //    - Compiled state machines
+    //----------------------------------------
+    lockShards();
+    freeCompiled();
+    unlockShards();
     // UNLOCK
     pthread_mutex_unlock(&g_SM_mutex);
 }
@@ -468,6 +1314,20 @@ void harpism_load(harpiLinkedList* element)
     harpiSTransitionArray = (harpiStateTransitionsData*)malloc(
         harpiSTransitionArrayLen * sizeof(harpiStateTransitionsData));
     //----------------------------------------
+    //    - State Timeouts
+    //----------------------------------------
+    // Clear array
+    if(harpiSTimeoutsArray != NULL)
+    {
+        free(harpiSTimeoutsArray);
+        harpiSTimeoutsArray = NULL;
+    }
+    // Get array size and allocate memory
+    harpiSTimeoutsArrayLen = harpi_getLinkedListNElements(
+        CSV_SECTION_STATE_TIMEOUTS);
+    harpiSTimeoutsArray = (harpiStateTimeoutsData*)malloc(
+        harpiSTimeoutsArrayLen * sizeof(harpiStateTimeoutsData));
+    //----------------------------------------
     // Create arrays from list
     //----------------------------------------
     isOK = copyListToArray(element);
@@ -480,37 +1340,101 @@ void harpism_load(harpiLinkedList* element)
     }
     // LOCK
     pthread_mutex_lock(&g_SM_mutex);
+    lockShards();
     // Init state machine array
     initStateMachinesArrays();
-    // Create and init timers
-    timer_createTimers(smIDArrayLen, smIDArray);
+    // Compile: [state][event] tables, event set -> state machines index
+    compileStateMachines();
+    unlockShards();
+    // Create and init timers (expirations: timerExpired)
+    timer_createTimers(smDataArrayLen, timerExpired);
     // UNLOCK
     pthread_mutex_unlock(&g_SM_mutex);
 }
 
 void harpism_periodic(void)
 {
-    int check;
-    bool retry;
-    harpiEvent_t event;    
-    retry = true;
-    while(retry)
-    {
-        // Check if there is a new event
-        check = harpievents_getEvent(&event);
-        if(check == HARPIEVENTS_NEW_EVENT)
-        {
-            // LOCK
-            pthread_mutex_lock(&g_SM_mutex);
-            // Check state machines
-            checkSMs(&event);
-            // UNLOCK
-            pthread_mutex_unlock(&g_SM_mutex);
-        }
-        else
+    harpiEvent_t events[HARPISM_EVENTS_BATCH];
+    hsmOutput_t output;
+    int count;
+    #ifndef HARPISM_SHARDS
+    int i;
+    #endif
+    initOutput(&output);
+    // Events queued only with HARPI_IMMEDIATE_DISPATCH undefined (harpi.h)
+    while(1)
+    {
+        // Get all the pending events (in order)
+        count = harpievents_getEvents(events, HARPISM_EVENTS_BATCH);
+        if(count <= 0)
         {
             // leave loop
-            retry = false;
+            break;
+        }
+        // LOCK
+        pthread_mutex_lock(&g_SM_mutex);
+        // Check state machines
+        #ifdef HARPISM_SHARDS
+        dispatchEvents(events, count, &output);
+        #else
+        for(i = 0; i < count; i++)
+        {
+            checkSMs(&events[i], 0, &output);
         }
+        #endif
+        // UNLOCK
+        pthread_mutex_unlock(&g_SM_mutex);
+        // Send actions / loads OFF
+        flushOutput(&output);
     }
-}
\ No newline at end of file
+}
+
+void harpism_handleEvents(harpiEvent_t* events, int count)
+{
+    hsmOutput_t output;
+    #ifndef HARPISM_SHARDS
+    int i;
+    #endif
+    if(count <= 0)
+    {
+        return;
+    }
+    initOutput(&output);
+    // LOCK
+    pthread_mutex_lock(&g_SM_mutex);
+    // Check state machines
+    #ifdef HARPISM_SHARDS
+    dispatchEvents(events, count, &output);
+    #else
+    for(i = 0; i < count; i++)
+    {
+        checkSMs(&events[i], 0, &output);
+    }
+    #endif
+    // UNLOCK
+    pthread_mutex_unlock(&g_SM_mutex);
+    // Send actions / loads OFF
+    flushOutput(&output);
+}
+
+uint32_t harpism_getShardDropped(int16_t shard, bool reset)
+{
+    uint32_t dropped;
+    dropped = 0;
+    #ifdef HARPISM_SHARDS
+    if( (shard < 0) || (shard >= HARPISM_SHARDS) )
+    {
+        return 0;
+    }
+    // LOCK
+    pthread_mutex_lock(&g_SM_mutex);
+    dropped = g_shardDropped[shard];
+    if(reset)
+    {
+        g_shardDropped[shard] = 0;
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_SM_mutex);
+    #endif
+    return dropped;
+}
@@ -6,6 +6,18 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - harpism_handleEvents: immediate dispatch of events                       //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - HARPISM_SHARDS: state machines evaluated by a pool of worker threads     //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - harpism_getShardDropped: events dropped by a full shard buffer           //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - harpism_periodic: batches only with HARPI_IMMEDIATE_DISPATCH undefined   //
+//----------------------------------------------------------------------------//
 
 #ifndef HARPISM_H
 #define HARPISM_H
@@ -21,6 +33,13 @@ extern "C" {
 //----------------------------------------------------------------------------//
 // EXTERNAL DEFINITIONS
 //----------------------------------------------------------------------------//    
+/* Sharded evaluation: the state machines are partitioned by index 
+ * (stateMachineID % HARPISM_SHARDS) across HARPISM_SHARDS worker threads. 
+ * Each shard has its own events buffer and checks its machines in event 
+ * order (the actions of a machine keep their order). Comment to check the
+ * state machines in the thread handling the events.
+ */
+#define HARPISM_SHARDS 3
 
     
 //----------------------------------------------------------------------------//
@@ -31,6 +50,15 @@ extern "C" {
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
+/**
+ * Create the shards (events buffers and worker threads) - to be called once
+ * (HARPISM_SHARDS, nothing to be done otherwise)
+ * 
+ * \return  EXIT_SUCCESS
+ *          EXIT_FAILURE
+ **/
+int harpism_createShards(void);
+
 /**
  * Init data:
  * - empty the list and if list is available, free used memory
@@ -46,11 +74,33 @@ void harpism_init(void);
 void harpism_load(harpiLinkedList* element);
 
 /**
- * Periodic check of state machine
+ * Periodic check of state machine: the pending events are drained from the 
+ * events buffer in batches (one lock per batch). Only used for events with 
+ * HARPI_IMMEDIATE_DISPATCH undefined (harpism_handleEvents otherwise)
  * 
  **/
 void harpism_periodic(void);
 
+/**
+ * Check the state machines for the given events right away (immediate 
+ * dispatch - events not added to the events buffer). With HARPISM_SHARDS the
+ * events are handed to the shards using them (checked by the workers).
+ * \param   events  (INPUT) events to be handled (in order)
+ *          count   (INPUT) number of events
+ * 
+ **/
+void harpism_handleEvents(harpiEvent_t* events, int count);
+
+/**
+ * Events dropped by a shard: its events buffer was full when they were 
+ * handed over (the thread handling the events never waits for a worker)
+ * \param   shard   (INPUT) shard (0 .. HARPISM_SHARDS - 1)
+ *          reset   (INPUT) clear the counter after reading it
+ * 
+ * \return  dropped events (0 without HARPISM_SHARDS)
+ **/
+uint32_t harpism_getShardDropped(int16_t shard, bool reset);
+
 #ifdef __cplusplus
 }
 #endif
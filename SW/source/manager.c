@@ -9,16 +9,36 @@
 //  1.01     | 30/Jul/2025 |                               | ALCP             //
 // - Updates to remove unused parts from HMSG 01.12                           //
 //----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Event driven mode (APP_EVENT_DRIVEN): epoll / eventfd / timerfd          //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - Periodic tick: harpi_enablePeriodic (scheduler deadlines)                //
+//----------------------------------------------------------------------------//
+//  1.04     | 16/Oct/2026 |                               | ALCP             //
+// - Event driven write thread: one eventfd per write lane                    //
+//----------------------------------------------------------------------------//
+//  1.05     | 16/Oct/2026 |                               | ALCP             //
+// - Periodic thread: deadline kept while disconnected (one-shot timerfd)     //
+//----------------------------------------------------------------------------//
+//  1.06     | 16/Oct/2026 |                               | ALCP             //
+// - Two write lanes (control lane removed)                                   //
+//----------------------------------------------------------------------------//
+//  1.07     | 16/Oct/2026 |                               | ALCP             //
+// - buffer.h removed (unused generic buffer)                                 //
+//----------------------------------------------------------------------------//
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
 #include <pthread.h>
+#include <sys/epoll.h>
 #include <app.h>
 #include <auxiliary.h>
-#include <buffer.h>
 #include <canbuf.h>
 #include <debug.h>
 #include <errorhandler.h>
@@ -26,12 +46,17 @@
 #include <manager.h>
 #include <csvconfig.h>
 #include <harpi.h>
+#include <harpievents.h>
 
 //----------------------------------------------------------------------------//
 // INTERNAL DEFINITIONS
 //----------------------------------------------------------------------------//
 #define NUMBER_OF_THREADS   6
 #define INIT_RETRIES    5
+// Event driven mode
+#define MANAGER_MAX_EVENT_FDS   2       // Write lanes (see canbuf.h)
+#define MANAGER_STATE_CHECK_MS  1000    // Re-check CAN state while waiting
+#define MANAGER_BUSY_RETRY_MS   2       // Write retry when socket is busy
 
 //----------------------------------------------------------------------------//
 // INTERNAL TYPES
@@ -60,9 +85,97 @@ vp_thread_t vp_thread[NUMBER_OF_THREADS] =
     managerHandleHAPCANPeriodic,        // Manage Periodic events (System)
     managerHandleConfigFile};           // Handle Config File Updates
 
+// Event driven mode: eventfds signalled on buffer push (-1: polling)
+static int g_readEventFD = -1;
+static int g_writeEventFD[CAN_NUMBER_OF_LANES] = {-1, -1};
+static int g_harpiEventFD = -1;
+// Event driven mode: timerfd signalled on periodic deadlines (-1: polling)
+static int g_harpiTickFD = -1;
+
 //----------------------------------------------------------------------------//
 // INTERNAL FUNCTIONS - AUXILIARY
 //----------------------------------------------------------------------------//
+static int managerEpollCreate(const int* fds, int count);
+static int managerEpollWait(int epfd, int timeout, int tickFD, 
+        useconds_t fallback);
+
+/* Create an epoll instance for the given file descriptors (input events).
+ * Returns -1 if the event driven mode is not available (the thread will use 
+ * the polling loop).
+ */
+static int managerEpollCreate(const int* fds, int count)
+{
+    #ifdef APP_EVENT_DRIVEN
+    int epfd;
+    int li_index;
+    struct epoll_event ev;
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    if(epfd < 0)
+    {
+        #ifdef DEBUG_MANAGER_ERRORS
+        debug_print("MANAGER: epoll create ERROR!\n");
+        #endif
+        return -1;
+    }
+    for(li_index = 0; li_index < count; li_index++)
+    {
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = fds[li_index];
+        if( (fds[li_index] < 0) || 
+                (epoll_ctl(epfd, EPOLL_CTL_ADD, fds[li_index], &ev) < 0) )
+        {
+            #ifdef DEBUG_MANAGER_ERRORS
+            debug_print("MANAGER: epoll add ERROR!\n");
+            debug_print("- FD = %d\n", fds[li_index]);
+            #endif
+            close(epfd);
+            return -1;
+        }
+    }
+    return epfd;
+    #else
+    return -1;
+    #endif
+}
+
+/* Sleep until one of the file descriptors is signalled or timeout (ms, -1 
+ * no timeout). The eventfd / timerfd counters are cleared before returning, 
+ * so anything pushed after this point signals again.
+ * Returns the number of expirations of tickFD (0 if not signalled).
+ * Without epoll (epfd < 0), sleeps "fallback" us and returns 1.
+ */
+static int managerEpollWait(int epfd, int timeout, int tickFD, 
+        useconds_t fallback)
+{
+    struct epoll_event events[MANAGER_MAX_EVENT_FDS];
+    uint64_t lull_count;
+    int li_ready;
+    int li_index;
+    int li_ticks;
+    if(epfd < 0)
+    {
+        usleep(fallback);
+        return 1;
+    }
+    li_ticks = 0;
+    li_ready = epoll_wait(epfd, events, MANAGER_MAX_EVENT_FDS, timeout);
+    for(li_index = 0; li_index < li_ready; li_index++)
+    {
+        // Clear counter (non-blocking)
+        lull_count = 0;
+        if(read(events[li_index].data.fd, &lull_count, 
+                sizeof(lull_count)) != sizeof(lull_count))
+        {
+            continue;
+        }
+        if(events[li_index].data.fd == tickFD)
+        {
+            li_ticks = (int)lull_count;
+        }
+    }
+    return li_ticks;
+}
 
 
 //----------------------------------------------------------------------------//
@@ -116,7 +229,10 @@ void* managerHandleCAN0Read(void *arg)
                     b_retry = b_retry && (check == CAN_RECEIVE_OK);                    
                 }
                 // 2ms delay after reading all messages while connected
+                // Event driven: canbuf_receive already sleeps on the socket
+                #ifndef APP_EVENT_DRIVEN
                 usleep(2000);
+                #endif
             }
             else
             {
@@ -133,8 +249,11 @@ void* managerHandleCAN0Write(void *arg)
 {
     const int channel = 0;
     int check;
+    int epfd;
     stateCAN_t sc_state;
     bool b_retry;
+    // Event driven: wake up on Write Buffer push (any lane)
+    epfd = managerEpollCreate(g_writeEventFD, CAN_NUMBER_OF_LANES);
     while(1)
     {
         /* STATE CHECK AND RE-INIT
@@ -155,7 +274,11 @@ void* managerHandleCAN0Write(void *arg)
                     b_retry = b_retry && (check == CAN_SEND_OK);
                 }
                 // 2ms delay after sending all messages while connected
-                usleep(2000);
+                // Event driven: sleep until new messages (retry in 2ms if 
+                // the socket is busy)
+                managerEpollWait(epfd, (check == CAN_SEND_BUSY) ? 
+                        MANAGER_BUSY_RETRY_MS : MANAGER_STATE_CHECK_MS, -1, 
+                        2000);
             }
             else
             {
@@ -177,6 +300,9 @@ void* managerHandleCAN0Buffers(void *arg)
     hapcanCANData hapcanData;
     unsigned long long timestamp;
     bool b_retry;
+    int epfd;
+    // Event driven: wake up on Read Buffer push
+    epfd = managerEpollCreate(&g_readEventFD, 1);
     while(1)
     {
         // STATE CHECK AND RE-INIT
@@ -206,7 +332,8 @@ void* managerHandleCAN0Buffers(void *arg)
                     }
                 }
                 // 2ms loop after empty buffer
-                usleep(2000); 
+                // Event driven: sleep until new messages
+                managerEpollWait(epfd, MANAGER_STATE_CHECK_MS, -1, 2000);
             }
             else
             {
@@ -221,9 +348,31 @@ void* managerHandleCAN0Buffers(void *arg)
 void* managerHandleHAPCANPeriodic(void *arg)
 {
     int check;
+    int epfd;
+    int tickFD;
+    int ticks;
+    int fds[MANAGER_MAX_EVENT_FDS];
+    bool b_due;
     stateCAN_t sc_state;
+    // Event driven: periodic deadlines (timerfd) and new events (eventfd)
+    epfd = -1;
+    tickFD = g_harpiTickFD;
+    if(tickFD >= 0)
+    {
+        fds[0] = tickFD;
+        fds[1] = g_harpiEventFD;
+        epfd = managerEpollCreate(fds, 2);
+    }
+    b_due = false;
     while(1)
     {
+        /* 5ms Loop (event driven: next deadline or new events). The timerfd 
+         * expires once: a deadline missed while disconnected is kept (b_due)
+         * and the CAN state re-checked until harpi_periodic sets it again.
+         */
+        ticks = managerEpollWait(epfd, b_due ? MANAGER_STATE_CHECK_MS : -1, 
+                tickFD, HARPI_PERIOD);
+        b_due = b_due || (ticks > 0);
         /* STATE CHECK AND RE-INIT */
         check = canbuf_getState(0, &sc_state);
         if( (check == EXIT_SUCCESS) && (sc_state == CAN_CONNECTED) )
@@ -233,10 +382,17 @@ void* managerHandleHAPCANPeriodic(void *arg)
             // module status
             //----------------------------------------------------------
             // Error is handled within the functions
-            harpi_periodic();
+            if(b_due)
+            {
+                harpi_periodic();
+                b_due = false;
+            }
+            else
+            {
+                // Only new events - no periodic checks
+                harpi_handleEvents();
+            }
         }
-        // 5ms Loop
-        usleep(5000);
     }
 }
 
@@ -276,6 +432,9 @@ void managerInit(void)
             APP_SW_SUB_VERSION);
     debug_print("HArpi Build date/time = %s - %s\n", __DATE__, __TIME__);
     #endif
+    #ifdef DEBUG_HARPIEVENTS_BENCHMARK
+    harpievents_benchmark();
+    #endif
     /**************************************************************************
      * INIT BUFFERS
      *************************************************************************/        
@@ -298,6 +457,18 @@ void managerInit(void)
         }
     }
 
+    // Event driven mode: buffer push notifications
+    #ifdef APP_EVENT_DRIVEN
+    g_readEventFD = canbuf_enableEvents(0, CAN_READ_BUFFER);
+    for(li_index = 0; li_index < CAN_NUMBER_OF_LANES; li_index++)
+    {
+        g_writeEventFD[li_index] = canbuf_enableEvents(0, 
+                CAN_WRITE_BUFFER + li_index);
+    }
+    g_harpiEventFD = harpi_enableEvents();
+    g_harpiTickFD = harpi_enablePeriodic();
+    #endif
+
     /**************************************************************************
      * INIT CONFIG AND GATEWAY
      *************************************************************************/
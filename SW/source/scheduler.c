@@ -0,0 +1,325 @@
+//----------------------------------------------------------------------------//
+//                               OBJECT HISTORY                               //
+//----------------------------------------------------------------------------//
+//  REVISION |    DATE     |                               |      AUTHOR      //
+//----------------------------------------------------------------------------//
+//  1.00     | 16/Oct/2026 |                               | ALCP             //
+// - First version                                                            //
+//----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - armTimer: one-shot timerfd at the next deadline (no interval)            //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - On demand jobs: scheduler_setDeadline / scheduler_clearDeadline          //
+//----------------------------------------------------------------------------//
+
+/*
+* Includes
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/timerfd.h>
+#include <debug.h>
+#include <scheduler.h>
+
+//----------------------------------------------------------------------------//
+// INTERNAL DEFINITIONS
+//----------------------------------------------------------------------------//
+#define NS_PER_US   1000ULL
+#define NS_PER_S    1000000000ULL
+#define NO_DEADLINE UINT64_MAX          // On demand job not scheduled
+
+//----------------------------------------------------------------------------//
+// INTERNAL TYPES
+//----------------------------------------------------------------------------//
+// Job (g_jobs index: job ID)
+typedef struct
+{
+    schedulerJob_t job;         // NULL: free
+    uint64_t period;            // ns (0: one-shot / on demand)
+    uint64_t deadline;          // ns - CLOCK_MONOTONIC (NO_DEADLINE)
+    bool onDemand;              // Kept after running (no deadline)
+    schedulerStats_t stats;
+} schedulerJobData_t;
+
+//----------------------------------------------------------------------------//
+// INTERNAL GLOBAL VARIABLES
+//----------------------------------------------------------------------------//
+static pthread_mutex_t g_Scheduler_mutex = PTHREAD_MUTEX_INITIALIZER;
+static schedulerJobData_t g_jobs[SCHEDULER_MAX_JOBS];
+static int g_schedulerFD = -1;
+
+//----------------------------------------------------------------------------//
+// INTERNAL FUNCTIONS
+//----------------------------------------------------------------------------//
+static uint64_t getTime(void);
+static int addJob(uint64_t delay, uint64_t period, bool onDemand, 
+        schedulerJob_t job);
+static void setDeadline(int jobID, uint64_t deadline);
+static void armTimer(void);
+
+// Monotonic time - ns
+static uint64_t getTime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NS_PER_S + (uint64_t)ts.tv_nsec;
+}
+
+// Add a job to a free position (on demand: no deadline) - returns the job ID
+static int addJob(uint64_t delay, uint64_t period, bool onDemand, 
+        schedulerJob_t job)
+{
+    int jobID;
+    int i;
+    if(job == NULL)
+    {
+        return SCHEDULER_ERROR;
+    }
+    jobID = SCHEDULER_ERROR;
+    // LOCK
+    pthread_mutex_lock(&g_Scheduler_mutex);
+    for(i = 0; i < SCHEDULER_MAX_JOBS; i++)
+    {
+        if(g_jobs[i].job == NULL)
+        {
+            memset(&g_jobs[i], 0, sizeof(schedulerJobData_t));
+            g_jobs[i].job = job;
+            g_jobs[i].period = period;
+            g_jobs[i].deadline = onDemand ? NO_DEADLINE : getTime() + delay;
+            g_jobs[i].onDemand = onDemand;
+            g_jobs[i].stats.period = (unsigned long)(period / NS_PER_US);
+            jobID = i;
+            armTimer();
+            break;
+        }
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_Scheduler_mutex);
+    #ifdef DEBUG_SCHEDULER_ERRORS
+    if(jobID == SCHEDULER_ERROR)
+    {
+        debug_print("scheduler - ERROR: no job available!\n");
+    }
+    #endif
+    return jobID;
+}
+
+// Set the deadline of an on demand job (NO_DEADLINE: not scheduled)
+static void setDeadline(int jobID, uint64_t deadline)
+{
+    // LOCK
+    pthread_mutex_lock(&g_Scheduler_mutex);
+    if( (jobID >= 0) && (jobID < SCHEDULER_MAX_JOBS) && 
+        (g_jobs[jobID].job != NULL) && g_jobs[jobID].onDemand )
+    {
+        g_jobs[jobID].deadline = deadline;
+        armTimer();
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_Scheduler_mutex);
+}
+
+/* Set the timerfd to expire once at the next deadline (absolute) or stop it
+ * if no jobs. Set again by scheduler_run (no interval: an idle system only 
+ * wakes up for its deadlines). (under g_Scheduler_mutex)
+ */
+static void armTimer(void)
+{
+    struct itimerspec its;
+    uint64_t next;
+    bool found;
+    int i;
+    if(g_schedulerFD < 0)
+    {
+        return;
+    }
+    found = false;
+    next = 0;
+    for(i = 0; i < SCHEDULER_MAX_JOBS; i++)
+    {
+        if( (g_jobs[i].job == NULL) || (g_jobs[i].deadline == NO_DEADLINE) )
+        {
+            continue;
+        }
+        if(!found || (g_jobs[i].deadline < next))
+        {
+            next = g_jobs[i].deadline;
+            found = true;
+        }
+    }
+    memset(&its, 0, sizeof(its));
+    if(found)
+    {
+        // Zero stops the timer: deadline at least 1ns
+        next = (next > 0) ? next : 1;
+        its.it_value.tv_sec = next / NS_PER_S;
+        its.it_value.tv_nsec = next % NS_PER_S;
+    }
+    if(timerfd_settime(g_schedulerFD, TFD_TIMER_ABSTIME, &its, NULL) < 0)
+    {
+        #ifdef DEBUG_SCHEDULER_ERRORS
+        debug_print("scheduler - ERROR: timerfd settime!\n");
+        #endif
+    }
+}
+
+//----------------------------------------------------------------------------//
+// EXTERNAL FUNCTIONS
+//----------------------------------------------------------------------------//
+int scheduler_addPeriodic(unsigned long period, schedulerJob_t job)
+{
+    if(period == 0)
+    {
+        return SCHEDULER_ERROR;
+    }
+    return addJob((uint64_t)period * NS_PER_US, (uint64_t)period * NS_PER_US, 
+        false, job);
+}
+
+int scheduler_addOneShot(unsigned long delay, schedulerJob_t job)
+{
+    return addJob((uint64_t)delay * NS_PER_US, 0, false, job);
+}
+
+int scheduler_addOnDemand(schedulerJob_t job)
+{
+    return addJob(0, 0, true, job);
+}
+
+void scheduler_setDeadline(int jobID, unsigned long delay)
+{
+    setDeadline(jobID, getTime() + (uint64_t)delay * NS_PER_US);
+}
+
+void scheduler_clearDeadline(int jobID)
+{
+    setDeadline(jobID, NO_DEADLINE);
+}
+
+void scheduler_cancel(int jobID)
+{
+    // LOCK
+    pthread_mutex_lock(&g_Scheduler_mutex);
+    if( (jobID >= 0) && (jobID < SCHEDULER_MAX_JOBS) )
+    {
+        g_jobs[jobID].job = NULL;
+        armTimer();
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_Scheduler_mutex);
+}
+
+int scheduler_enableEvents(void)
+{
+    // LOCK
+    pthread_mutex_lock(&g_Scheduler_mutex);
+    if(g_schedulerFD < 0)
+    {
+        g_schedulerFD = timerfd_create(CLOCK_MONOTONIC, 
+            TFD_NONBLOCK | TFD_CLOEXEC);
+        #ifdef DEBUG_SCHEDULER_ERRORS
+        if(g_schedulerFD < 0)
+        {
+            debug_print("scheduler - ERROR: timerfd create!\n");
+        }
+        #endif
+        armTimer();
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_Scheduler_mutex);
+    return g_schedulerFD;
+}
+
+void scheduler_run(void)
+{
+    schedulerJob_t due[SCHEDULER_MAX_JOBS];
+    schedulerJobData_t* job;
+    uint64_t now;
+    uint64_t lateness;
+    uint64_t missed;
+    int count;
+    int i;
+    count = 0;
+    now = getTime();
+    // LOCK
+    pthread_mutex_lock(&g_Scheduler_mutex);
+    for(i = 0; i < SCHEDULER_MAX_JOBS; i++)
+    {
+        job = &g_jobs[i];
+        if( (job->job == NULL) || (job->deadline > now) )
+        {
+            continue;
+        }
+        // Statistics
+        lateness = (now - job->deadline) / NS_PER_US;
+        job->stats.runs++;
+        job->stats.lastLateness = lateness;
+        job->stats.totalLateness += lateness;
+        if(lateness > job->stats.maxLateness)
+        {
+            job->stats.maxLateness = lateness;
+        }
+        due[count] = job->job;
+        count++;
+        // Next deadline: skip the missed periods / on demand: wait for 
+        // scheduler_setDeadline / one-shot done
+        if(job->period > 0)
+        {
+            missed = (now - job->deadline) / job->period;
+            job->deadline += (missed + 1) * job->period;
+            job->stats.missed += missed;
+            #ifdef DEBUG_SCHEDULER_ERRORS
+            if(missed > 0)
+            {
+                debug_print("scheduler - job %d late: %llu us (%llu periods "
+                    "skipped)\n", i, (unsigned long long)lateness, 
+                    (unsigned long long)missed);
+            }
+            #endif
+        }
+        else if(job->onDemand)
+        {
+            job->deadline = NO_DEADLINE;
+        }
+        else
+        {
+            job->job = NULL;
+        }
+    }
+    armTimer();
+    // UNLOCK
+    pthread_mutex_unlock(&g_Scheduler_mutex);
+    // Run (NOT locked: the jobs may add / cancel jobs)
+    for(i = 0; i < count; i++)
+    {
+        due[i]();
+    }
+}
+
+int scheduler_getStats(int jobID, schedulerStats_t* stats, bool reset)
+{
+    int ret;
+    ret = EXIT_FAILURE;
+    // LOCK
+    pthread_mutex_lock(&g_Scheduler_mutex);
+    if( (jobID >= 0) && (jobID < SCHEDULER_MAX_JOBS) && 
+        (g_jobs[jobID].job != NULL) )
+    {
+        *stats = g_jobs[jobID].stats;
+        if(reset)
+        {
+            memset(&g_jobs[jobID].stats, 0, sizeof(schedulerStats_t));
+            g_jobs[jobID].stats.period = stats->period;
+        }
+        ret = EXIT_SUCCESS;
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_Scheduler_mutex);
+    return ret;
+}
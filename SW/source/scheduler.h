@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------//
+//                               OBJECT HISTORY                               //
+//----------------------------------------------------------------------------//
+//  REVISION |    DATE     |                               |      AUTHOR      //
+//----------------------------------------------------------------------------//
+//  1.00     | 16/Oct/2026 |                               | ALCP             //
+// - First version                                                            //
+//----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - scheduler_enableEvents: timerfd expires once per deadline                //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - scheduler_addOnDemand, scheduler_setDeadline / scheduler_clearDeadline   //
+//----------------------------------------------------------------------------//
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//----------------------------------------------------------------------------//
+// EXTERNAL DEFINITIONS
+//----------------------------------------------------------------------------//
+#define SCHEDULER_MAX_JOBS  8
+#define SCHEDULER_ERROR     -1
+    
+//----------------------------------------------------------------------------//
+// EXTERNAL TYPES
+//----------------------------------------------------------------------------//
+// Job (called by scheduler_run, scheduler NOT locked)
+typedef void (*schedulerJob_t)(void);
+
+// Job statistics (lateness: run time - deadline)
+typedef struct
+{
+    unsigned long period;               // us (0: one-shot / on demand)
+    unsigned long long runs;
+    unsigned long long missed;          // Periods skipped (late runs)
+    unsigned long long lastLateness;    // us
+    unsigned long long maxLateness;     // us
+    unsigned long long totalLateness;   // us (average: total / runs)
+} schedulerStats_t;
+    
+//----------------------------------------------------------------------------//
+// EXTERNAL FUNCTIONS
+//----------------------------------------------------------------------------//
+/**
+ * Add a periodic job: absolute deadlines (CLOCK_MONOTONIC) every period, 
+ * starting one period from now. A late run skips the missed periods (no 
+ * burst of runs).
+ * 
+ * \param       period: us
+ *              job: function to be called
+ * 
+ * \return      job ID / SCHEDULER_ERROR
+ **/
+int scheduler_addPeriodic(unsigned long period, schedulerJob_t job);
+
+/**
+ * Add a one-shot job (removed after running)
+ * 
+ * \param       delay: us from now
+ *              job: function to be called
+ * 
+ * \return      job ID / SCHEDULER_ERROR
+ **/
+int scheduler_addOneShot(unsigned long delay, schedulerJob_t job);
+
+/**
+ * Add an on demand job: kept until removed but only run at the deadline set
+ * by scheduler_setDeadline (once per deadline)
+ * 
+ * \param       job: function to be called
+ * 
+ * \return      job ID / SCHEDULER_ERROR
+ **/
+int scheduler_addOnDemand(schedulerJob_t job);
+
+/**
+ * Set (replace) the deadline of an on demand job
+ * 
+ * \param       jobID: job ID (scheduler_addOnDemand)
+ *              delay: us from now
+ * 
+ **/
+void scheduler_setDeadline(int jobID, unsigned long delay);
+
+/**
+ * Clear the deadline of an on demand job (not run until set again)
+ * 
+ * \param       jobID: job ID (scheduler_addOnDemand)
+ * 
+ **/
+void scheduler_clearDeadline(int jobID);
+
+/**
+ * Remove a job
+ * 
+ * \param       jobID: job ID
+ * 
+ **/
+void scheduler_cancel(int jobID);
+
+/**
+ * Enable the deadline notifications: the returned timerfd (CLOCK_MONOTONIC) 
+ * expires once at the next deadline. Call scheduler_run when it is signalled
+ * (it sets the timerfd to the following deadline).
+ * 
+ * \return      timerfd (non-blocking) / -1 on error
+ **/
+int scheduler_enableEvents(void);
+
+/**
+ * Run the jobs whose deadline is due (and set the timerfd to the next one).
+ * Without scheduler_enableEvents, to be called periodically.
+ **/
+void scheduler_run(void);
+
+/**
+ * Get the statistics of a job
+ * 
+ * \param       jobID: job ID
+ *              stats: (OUTPUT) statistics
+ *              reset: true to restart the counters
+ * 
+ * \return      EXIT_SUCCESS / EXIT_FAILURE (no job)
+ **/
+int scheduler_getStats(int jobID, schedulerStats_t* stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
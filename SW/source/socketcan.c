@@ -6,19 +6,34 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First Version: copied from HMSG 01.12                                    //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - Batched read with recvmmsg (socketcan_readBatch)                         //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Batched write with sendmmsg (socketcan_writeBatch)                       //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - Kernel receive timestamps (SO_TIMESTAMPING / SO_TIMESTAMPNS) in ns       //
+//----------------------------------------------------------------------------//
 
+// recvmmsg / sendmmsg
+#define _GNU_SOURCE
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <string.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <poll.h>
+#include <stdbool.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <net/if.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
 #include "debug.h"
 #include "auxiliary.h"
 #include "socketcan.h"
@@ -30,6 +45,62 @@
 //----------------------------------------------------------------------------//
 // INTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
+static void socketcan_enableTimestamps(int fd);
+static uint64_t socketcan_getTimestamp(struct msghdr* pmh_Msg);
+
+/* Enable the kernel receive timestamps: SO_TIMESTAMPING (software receive 
+ * time) and, if not supported, SO_TIMESTAMPNS. If both fail the frames are 
+ * read without timestamp (socketcan_getTimestamp returns 0).
+ */
+static void socketcan_enableTimestamps(int fd)
+{
+    int li_flags;
+    li_flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if(setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &li_flags, 
+            sizeof(li_flags)) == 0)
+    {
+        return;
+    }
+    li_flags = 1;
+    if(setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &li_flags, 
+            sizeof(li_flags)) == 0)
+    {
+        return;
+    }
+    #if defined(DEBUG_SOCKETCAN_ERROR) || defined(DEBUG_SOCKETCAN_OPEN)
+    debug_print("SocketCAN: Kernel Timestamps not available - FD: %d\n", fd);
+    #endif
+}
+
+/* Get the kernel receive timestamp (nanoseconds since epoch) from the 
+ * control messages. Returns 0 if not available.
+ */
+static uint64_t socketcan_getTimestamp(struct msghdr* pmh_Msg)
+{
+    struct cmsghdr* pcm_Cmsg;
+    struct timespec* pts_Time;
+    for(pcm_Cmsg = CMSG_FIRSTHDR(pmh_Msg); pcm_Cmsg != NULL; 
+            pcm_Cmsg = CMSG_NXTHDR(pmh_Msg, pcm_Cmsg))
+    {
+        if(pcm_Cmsg->cmsg_level != SOL_SOCKET)
+        {
+            continue;
+        }
+        if( (pcm_Cmsg->cmsg_type == SCM_TIMESTAMPING) || 
+                (pcm_Cmsg->cmsg_type == SCM_TIMESTAMPNS) )
+        {
+            // SCM_TIMESTAMPING: ts[0] is the software timestamp
+            // SCM_TIMESTAMPNS: single timespec
+            pts_Time = (struct timespec*)CMSG_DATA(pcm_Cmsg);
+            if( (pts_Time->tv_sec != 0) || (pts_Time->tv_nsec != 0) )
+            {
+                return (uint64_t)pts_Time->tv_sec * 1000000000ULL + 
+                        (uint64_t)pts_Time->tv_nsec;
+            }
+        }
+    }
+    return 0;
+}
 
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
@@ -109,6 +180,9 @@ int socketcan_open(int channel)
         return -1;
     }
 
+    // Kernel receive timestamps (not critical)
+    socketcan_enableTimestamps(fd);
+
     // Return file descriptor
     #if defined(DEBUG_SOCKETCAN_OPEN) || defined(DEBUG_SOCKETCAN_OPENED)
     debug_print("SocketCAN: Open Successful - Socket Channel: %d\n", channel);
@@ -229,6 +303,137 @@ int socketcan_read(int fd, struct can_frame* pcf_Frame, int timeout)
     return SOCKETCAN_OK;
 }
 
+/* Reads up to maxFrames frames from the CAN-bus with a single syscall */
+int socketcan_readBatch(int fd, struct can_frame* pcf_Frames, 
+        uint64_t* pull_Timestamps, int maxFrames, int timeout)
+{
+    int i_Temp;
+    int li_index;
+    int li_valid;
+    bool b_errorFrame;
+    struct pollfd pfds[1];
+    struct iovec iov[SOCKETCAN_MAX_BATCH];
+    struct mmsghdr msgs[SOCKETCAN_MAX_BATCH];
+    // Control messages (timestamps): one per frame
+    char ctrl[SOCKETCAN_MAX_BATCH][CMSG_SPACE(sizeof(struct scm_timestamping))];
+
+    // Limit batch
+    if(maxFrames > SOCKETCAN_MAX_BATCH)
+    {
+        maxFrames = SOCKETCAN_MAX_BATCH;
+    }
+    if(maxFrames <= 0)
+    {
+        return SOCKETCAN_OTHER_ERROR;
+    }
+
+    pfds[0].fd = fd;
+    pfds[0].events = POLLIN;
+
+    // Check if there is data available
+    i_Temp = poll(pfds, 1, timeout);
+    if(i_Temp == 0)
+    {
+        #ifdef DEBUG_SOCKETCAN_READ_FULL
+        debug_print("SocketCAN: Read Batch Poll Error (Timeout)!\n");
+        debug_print("- File: %d\n", fd);
+        #endif
+        return SOCKETCAN_TIMEOUT;
+    }
+    else if(i_Temp < 0)
+    {
+        #if defined(DEBUG_SOCKETCAN_READ_FULL) || defined(DEBUG_SOCKETCAN_ERROR)
+        debug_print("SocketCAN: Read Batch Poll Error (Generic)!\n");
+        debug_print("- File: %d\n", fd);
+        debug_print("- Error: %d\n", i_Temp);
+        #endif
+        return SOCKETCAN_ERROR;
+    }
+
+    // One message per frame - the frames are written directly to pcf_Frames
+    memset(msgs, 0, sizeof(struct mmsghdr) * maxFrames);
+    for(li_index = 0; li_index < maxFrames; li_index++)
+    {
+        iov[li_index].iov_base = &pcf_Frames[li_index];
+        iov[li_index].iov_len = sizeof(struct can_frame);
+        msgs[li_index].msg_hdr.msg_iov = &iov[li_index];
+        msgs[li_index].msg_hdr.msg_iovlen = 1;
+        msgs[li_index].msg_hdr.msg_control = ctrl[li_index];
+        msgs[li_index].msg_hdr.msg_controllen = sizeof(ctrl[li_index]);
+    }
+
+    // Read all available frames (up to maxFrames) without blocking
+    i_Temp = recvmmsg(fd, msgs, maxFrames, MSG_DONTWAIT, NULL);
+    if(i_Temp <= 0)
+    {
+        // Error, no frames read
+        #ifdef DEBUG_SOCKETCAN_READ_FULL
+        debug_print("SocketCAN: No Frames Read (Batch)!\n");
+        debug_print("- File: %d\n", fd);
+        #endif
+        return SOCKETCAN_OTHER_ERROR;
+    }
+
+    // Check each frame: remove incomplete and error frames, clear flags
+    li_valid = 0;
+    b_errorFrame = false;
+    for(li_index = 0; li_index < i_Temp; li_index++)
+    {
+        // Number of bytes check (according to manual, it is a paranoid check)
+        if(msgs[li_index].msg_len < sizeof(struct can_frame))
+        {
+            #if defined(DEBUG_SOCKETCAN_READ_FULL) || defined(DEBUG_SOCKETCAN_ERROR)
+            debug_print("SocketCAN: Incomplete Bytes Read (Batch)!\n");
+            debug_print("- File: %d\n", fd);
+            debug_print("- Bytes Read: %d\n", msgs[li_index].msg_len);
+            #endif
+            continue;
+        }
+        // Check for error frame
+        if(pcf_Frames[li_index].can_id & CAN_ERR_FLAG)
+        {
+            #if defined(DEBUG_SOCKETCAN_READ_FULL) || defined(DEBUG_SOCKETCAN_ERROR)
+            debug_print("SocketCAN ERROR: Error Frame Detected!\n");
+            #endif
+            b_errorFrame = true;
+            continue;
+        }
+        // Keep frame (compact) and its kernel timestamp
+        if(li_valid != li_index)
+        {
+            pcf_Frames[li_valid] = pcf_Frames[li_index];
+        }
+        if(pull_Timestamps != NULL)
+        {
+            pull_Timestamps[li_valid] = socketcan_getTimestamp(
+                    &msgs[li_index].msg_hdr);
+        }
+        pcf_Frames[li_valid].can_id = (pcf_Frames[li_valid].can_id &
+                CAN_EFF_MASK);
+        li_valid++;
+    }
+
+    // Debug Event
+    #ifdef DEBUG_SOCKETCAN_READ_EVENTS
+    debug_print("SocketCAN Read: %d New Frames Read. FD = %d!\n", li_valid,
+            fd);
+    #endif
+
+    // Return
+    if(li_valid > 0)
+    {
+        return li_valid;
+    }
+    else if(b_errorFrame)
+    {
+        return SOCKETCAN_ERROR_FRAME;
+    }
+    else
+    {
+        return SOCKETCAN_OTHER_ERROR;
+    }
+}
+
 /* Writes the data to the CAN-bus */
 int socketcan_write(int fd, struct can_frame* pcf_Frame)
 {
@@ -265,4 +470,67 @@ int socketcan_write(int fd, struct can_frame* pcf_Frame)
     debug_print("SocketCAN: Write OK!\n");
     #endif
     return 0;
-}
\ No newline at end of file
+}
+
+/* Writes several frames to the CAN-bus with a single syscall */
+int socketcan_writeBatch(int fd, struct can_frame* pcf_Frames, int count)
+{
+    int i_Temp;
+    int li_index;
+    struct iovec iov[SOCKETCAN_MAX_BATCH];
+    struct mmsghdr msgs[SOCKETCAN_MAX_BATCH];
+
+    // Limit batch
+    if(count > SOCKETCAN_MAX_BATCH)
+    {
+        count = SOCKETCAN_MAX_BATCH;
+    }
+    if(count <= 0)
+    {
+        return SOCKETCAN_ERROR;
+    }
+
+    // One message per frame
+    memset(msgs, 0, sizeof(struct mmsghdr) * count);
+    for(li_index = 0; li_index < count; li_index++)
+    {
+        // Adjust to Extended ID
+        pcf_Frames[li_index].can_id = pcf_Frames[li_index].can_id | 
+                CAN_EFF_FLAG;
+        iov[li_index].iov_base = &pcf_Frames[li_index];
+        iov[li_index].iov_len = sizeof(struct can_frame);
+        msgs[li_index].msg_hdr.msg_iov = &iov[li_index];
+        msgs[li_index].msg_hdr.msg_iovlen = 1;
+    }
+
+    // Write Frames - stops on the first frame that can not be queued
+    i_Temp = sendmmsg(fd, msgs, count, MSG_DONTWAIT);
+    if(i_Temp < 0)
+    {
+        if( (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS) )
+        {
+            // Transmit queue full: nothing written, nothing lost
+            #ifdef DEBUG_SOCKETCAN_WRITE
+            debug_print("SocketCAN: Write Batch BUSY!\n");
+            #endif
+            return SOCKETCAN_BUSY;
+        }
+        // Error, no data written
+        #if defined(DEBUG_SOCKETCAN_WRITE) || defined(DEBUG_SOCKETCAN_ERROR)
+        debug_print("SocketCAN: Write Batch ERROR!\n");
+        debug_print("- File: %d\n", fd);
+        debug_print("- Error: %d\n", errno);
+        #endif
+        return SOCKETCAN_ERROR;
+    }
+    if(i_Temp == 0)
+    {
+        return SOCKETCAN_BUSY;
+    }
+
+    // At this point, i_Temp frames were written OK!
+    #ifdef DEBUG_SOCKETCAN_WRITE
+    debug_print("SocketCAN: Write Batch OK: %d/%d frames!\n", i_Temp, count);
+    #endif
+    return i_Temp;
+}
@@ -6,6 +6,15 @@
 //  1.00     | 30/Jul/2025 |                               | ALCP             //
 // - First Version: copied from HMSG 01.12                                    //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - Batched read with recvmmsg (socketcan_readBatch)                         //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Batched write with sendmmsg (socketcan_writeBatch)                       //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - Kernel receive timestamps (SO_TIMESTAMPING / SO_TIMESTAMPNS) in ns       //
+//----------------------------------------------------------------------------//
 
 #ifndef SOCKETCAN_H
 #define SOCKETCAN_H
@@ -26,6 +35,9 @@ extern "C" {
 #define SOCKETCAN_TIMEOUT       -2
 #define SOCKETCAN_ERROR_FRAME   -3
 #define SOCKETCAN_OTHER_ERROR   -4
+#define SOCKETCAN_BUSY          -5  // Transmit queue full - try again later
+// Maximum number of frames read / written with a single syscall
+#define SOCKETCAN_MAX_BATCH     64
 
 //----------------------------------------------------------------------------//
 // EXTERNAL TYPES
@@ -36,7 +48,8 @@ extern "C" {
 //----------------------------------------------------------------------------//
 
 /**
- * Opens the connection to the CAN-bus.
+ * Opens the connection to the CAN-bus. Kernel receive timestamps are enabled
+ * (SO_TIMESTAMPING, or SO_TIMESTAMPNS if not supported).
  *
  * \param channel       Channel 0: can0 / Channel 1: can1
  * \return              file pointer on success, -1 on error
@@ -60,6 +73,25 @@ void socketcan_close(int fd);
 int socketcan_read(int fd, struct can_frame* pcf_Frame, int timeout);
 
 
+/**
+ * Reads all the frames available on the CAN-bus (up to maxFrames) with a 
+ * single syscall (recvmmsg), after waiting for the first one with poll.
+ * \param pcf_Frames    where to save the data (maxFrames positions)
+ * \param pull_Timestamps   where to save the kernel receive timestamps in 
+ *                      nanoseconds since epoch (maxFrames positions, 0 if not 
+ *                      available). NULL if not needed.
+ * \param maxFrames     maximum number of frames (1..SOCKETCAN_MAX_BATCH)
+ * \param timeout       milliseconds, -1 equals no timeout
+ * \return              >0                      number of frames read
+ *                      SOCKETCAN_ERROR         poll error (generic)
+ *                      SOCKETCAN_TIMEOUT       timeout (no data)
+ *                      SOCKETCAN_ERROR_FRAME   only error frames read
+ *                      SOCKETCAN_OTHER_ERROR   read error or data size error
+ */
+int socketcan_readBatch(int fd, struct can_frame* pcf_Frames, 
+        uint64_t* pull_Timestamps, int maxFrames, int timeout);
+
+
 /**
  * Writes the data to the CAN-bus
  * \param pcf_Frame     data to be written
@@ -68,6 +100,19 @@ int socketcan_read(int fd, struct can_frame* pcf_Frame, int timeout);
 int socketcan_write(int fd, struct can_frame* pcf_Frame);
 
 
+/**
+ * Writes several frames to the CAN-bus with a single syscall (sendmmsg)
+ * \param pcf_Frames    data to be written
+ * \param count         number of frames (1..SOCKETCAN_MAX_BATCH)
+ * \return              >0                      number of frames written (the
+ *                                              first ones, may be < count)
+ *                      SOCKETCAN_BUSY          no frame written, transmit
+ *                                              queue full (EAGAIN / ENOBUFS)
+ *                      SOCKETCAN_ERROR         no frame written, write error
+ */
+int socketcan_writeBatch(int fd, struct can_frame* pcf_Frames, int count);
+
+
 #ifdef __cplusplus
 }
 #endif
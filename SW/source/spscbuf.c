@@ -0,0 +1,397 @@
+//----------------------------------------------------------------------------//
+//                               OBJECT HISTORY                               //
+//----------------------------------------------------------------------------//
+//  REVISION |    DATE     |                               |      AUTHOR      //
+//----------------------------------------------------------------------------//
+//  1.00     | 16/Oct/2026 |                               | ALCP             //
+// - First Version: lock-free single producer / single consumer buffer        //
+//----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - Push notifications with eventfd (spscbuf_enableEvents)                   //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Buffers may be created while others are in use (release / acquire)       //
+//----------------------------------------------------------------------------//
+
+/*
+ * Includes
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include "spscbuf.h"
+
+//----------------------------------------------------------------------------//
+// INTERNAL DEFINITIONS
+//----------------------------------------------------------------------------//
+#define MAXIMUM_NUMBER_OF_SPSC_BUFFERS  10
+#define MAXIMUM_NUMBER_OF_SPSC_ELEMENTS 4096
+#define SPSCBUF_CACHE_LINE  64
+
+//----------------------------------------------------------------------------//
+// INTERNAL TYPES
+//----------------------------------------------------------------------------//
+typedef struct
+{
+    // Written only by the producer
+    alignas(SPSCBUF_CACHE_LINE) atomic_uint head;  // Next position to push
+    // Written only by the consumer
+    alignas(SPSCBUF_CACHE_LINE) atomic_uint tail;  // Next position to pop
+    // Clean request (any thread) - applied by the consumer
+    alignas(SPSCBUF_CACHE_LINE) atomic_bool cleanRequest;
+    atomic_uint cleanHead;  // Head when the clean was requested
+    // Read only after init
+    alignas(SPSCBUF_CACHE_LINE) unsigned int elements;  // Power of 2
+    unsigned int mask;  // elements - 1
+    unsigned int elementSize;  // Size of each slot
+    unsigned char* data;  // Contiguous slots: elements * elementSize bytes
+    int eventFD;  // Signalled on push (-1: not enabled)
+} spscbuf_t;
+
+//----------------------------------------------------------------------------//
+// INTERNAL GLOBAL VARIABLES
+//----------------------------------------------------------------------------//
+static atomic_int i_NumberOfBuffers = 0;
+static spscbuf_t buffers[MAXIMUM_NUMBER_OF_SPSC_BUFFERS];
+static pthread_mutex_t spscbuf_initMutex = PTHREAD_MUTEX_INITIALIZER;
+
+//----------------------------------------------------------------------------//
+// INTERNAL FUNCTIONS
+//----------------------------------------------------------------------------//
+static bool spscbuf_isValidID(int id);
+static unsigned char* spscbuf_Slot(int id, unsigned int index);
+static unsigned int spscbuf_applyClean(int id);
+static void spscbuf_signal(int id);
+
+/* Check the buffer ID. The buffers are never removed: a buffer created while
+ * others are in use is published (filled) before the number of buffers is 
+ * incremented (release / acquire).
+ */
+static bool spscbuf_isValidID(int id)
+{
+    return (id >= 0) && 
+        (id < atomic_load_explicit(&i_NumberOfBuffers, memory_order_acquire));
+}
+
+/* Returns the address of the slot for a given (free running) index
+ */
+static unsigned char* spscbuf_Slot(int id, unsigned int index)
+{
+    return &(buffers[id].data[(index & buffers[id].mask) *
+        buffers[id].elementSize]);
+}
+
+/* Apply a pending clean request (consumer only): discard up to the requested
+ * head. Returns the consumer index (tail) to be used.
+ */
+static unsigned int spscbuf_applyClean(int id)
+{
+    unsigned int lui_tail;
+    unsigned int lui_cleanHead;
+    // Own index: relaxed
+    lui_tail = atomic_load_explicit(&buffers[id].tail, memory_order_relaxed);
+    if(atomic_exchange_explicit(&buffers[id].cleanRequest, false,
+        memory_order_acquire))
+    {
+        lui_cleanHead = atomic_load_explicit(&buffers[id].cleanHead,
+            memory_order_relaxed);
+        if((int)(lui_cleanHead - lui_tail) > 0)
+        {
+            lui_tail = lui_cleanHead;
+            atomic_store_explicit(&buffers[id].tail, lui_tail,
+                memory_order_release);
+        }
+    }
+    return lui_tail;
+}
+
+/* Signal the consumer (if enabled) after a push
+ */
+static void spscbuf_signal(int id)
+{
+    uint64_t lull_one = 1;
+    if(buffers[id].eventFD >= 0)
+    {
+        // Non-blocking: if the counter is saturated the consumer is awake
+        if(write(buffers[id].eventFD, &lull_one, sizeof(lull_one)) < 0)
+        {
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+// EXTERNAL FUNCTIONS
+//----------------------------------------------------------------------------//
+/* Buffer Initialization
+ */
+int spscbuf_init(unsigned int elements, unsigned int size)
+{
+    int i_BufferID;
+    unsigned int lui_elements;
+    unsigned char* lucp_data;
+    // LOCK - INIT: In case more threads try to create a buffer at the same time
+    pthread_mutex_lock(&spscbuf_initMutex);
+    // Check buffer conditions
+    if(i_NumberOfBuffers >= MAXIMUM_NUMBER_OF_SPSC_BUFFERS)
+    {
+        pthread_mutex_unlock(&spscbuf_initMutex);
+        return SPSCBUF_ERROR_TOO_MANY_BUFFERS;
+    }
+    if( (elements == 0) || (elements > MAXIMUM_NUMBER_OF_SPSC_ELEMENTS) )
+    {
+        pthread_mutex_unlock(&spscbuf_initMutex);
+        return SPSCBUF_ERROR_TOO_MANY_ELEMENTS;
+    }
+    // Round up to a power of 2: index to slot is a mask operation
+    lui_elements = 1;
+    while(lui_elements < elements)
+    {
+        lui_elements = lui_elements << 1;
+    }
+    // Allocate all slots now - push / pop will only copy data
+    lucp_data = malloc((size_t)lui_elements * size);
+    if(lucp_data == NULL)
+    {
+        pthread_mutex_unlock(&spscbuf_initMutex);
+        return SPSCBUF_ERROR_NO_MEMORY;
+    }
+    // Define the Buffer ID as i_NumberOfBuffers
+    i_BufferID = atomic_load_explicit(&i_NumberOfBuffers, 
+        memory_order_relaxed);
+    // Fill Buffer
+    atomic_init(&buffers[i_BufferID].head, 0);
+    atomic_init(&buffers[i_BufferID].tail, 0);
+    atomic_init(&buffers[i_BufferID].cleanRequest, false);
+    atomic_init(&buffers[i_BufferID].cleanHead, 0);
+    buffers[i_BufferID].elements = lui_elements;
+    buffers[i_BufferID].mask = lui_elements - 1;
+    buffers[i_BufferID].elementSize = size;
+    buffers[i_BufferID].data = lucp_data;
+    buffers[i_BufferID].eventFD = -1;
+    // Only make the buffer visible when it is filled
+    atomic_store_explicit(&i_NumberOfBuffers, i_BufferID + 1, 
+        memory_order_release);
+    // UNLOCK - INIT
+    pthread_mutex_unlock(&spscbuf_initMutex);
+    // return BufferID
+    return i_BufferID;
+}
+
+/* Enable push notifications
+ */
+int spscbuf_enableEvents(int id)
+{
+    if(!spscbuf_isValidID(id))
+    {
+        return -1;
+    }
+    if(buffers[id].eventFD < 0)
+    {
+        buffers[id].eventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+    return buffers[id].eventFD;
+}
+
+/* Returns count of elements filled
+ */
+unsigned int spscbuf_dataCount(int id)
+{
+    unsigned int lui_head;
+    unsigned int lui_tail;
+    if(!spscbuf_isValidID(id))
+    {
+        return 0;
+    }
+    lui_tail = atomic_load_explicit(&buffers[id].tail, memory_order_acquire);
+    lui_head = atomic_load_explicit(&buffers[id].head, memory_order_acquire);
+    // Return
+    return lui_head - lui_tail;
+}
+
+/* Add data to Buffer - Producer only
+ */
+int spscbuf_push(int id, const void *data)
+{
+    unsigned int lui_head;
+    unsigned int lui_tail;
+    // Check ID
+    if(!spscbuf_isValidID(id))
+    {
+        // Nothing is pushed - wrong buffer ID
+        return SPSCBUF_WRONG_ID;
+    }
+    // Own index: relaxed / Consumer index: acquire (slot is free to be used)
+    lui_head = atomic_load_explicit(&buffers[id].head, memory_order_relaxed);
+    lui_tail = atomic_load_explicit(&buffers[id].tail, memory_order_acquire);
+    // Check if buffer is full
+    if((lui_head - lui_tail) >= buffers[id].elements)
+    {
+        return SPSCBUF_FULL;
+    }
+    // Copy to the slot and publish it
+    memcpy(spscbuf_Slot(id, lui_head), data, buffers[id].elementSize);
+    atomic_store_explicit(&buffers[id].head, lui_head + 1,
+        memory_order_release);
+    // Wake up the consumer
+    spscbuf_signal(id);
+    // Return
+    return SPSCBUF_OK;
+}
+
+/* Add several elements to Buffer - Producer only
+ */
+int spscbuf_pushN(int id, const void *data, unsigned int count)
+{
+    unsigned int lui_head;
+    unsigned int lui_tail;
+    unsigned int lui_free;
+    unsigned int lui_index;
+    const unsigned char* lucp_data;
+    // Check ID
+    if(!spscbuf_isValidID(id))
+    {
+        // Nothing is pushed - wrong buffer ID
+        return SPSCBUF_WRONG_ID;
+    }
+    // Own index: relaxed / Consumer index: acquire (slots are free to be used)
+    lui_head = atomic_load_explicit(&buffers[id].head, memory_order_relaxed);
+    lui_tail = atomic_load_explicit(&buffers[id].tail, memory_order_acquire);
+    // Limit to the free positions
+    lui_free = buffers[id].elements - (lui_head - lui_tail);
+    if(count > lui_free)
+    {
+        count = lui_free;
+    }
+    // Copy to the slots and publish all of them with a single store
+    lucp_data = data;
+    for(lui_index = 0; lui_index < count; lui_index++)
+    {
+        memcpy(spscbuf_Slot(id, lui_head + lui_index),
+            &lucp_data[lui_index * buffers[id].elementSize],
+            buffers[id].elementSize);
+    }
+    atomic_store_explicit(&buffers[id].head, lui_head + count,
+        memory_order_release);
+    // Wake up the consumer
+    if(count > 0)
+    {
+        spscbuf_signal(id);
+    }
+    // Return
+    return (int)count;
+}
+
+/* Remove data from Buffer - Consumer only
+ */
+int spscbuf_pop(int id, void *data)
+{
+    unsigned int lui_head;
+    unsigned int lui_tail;
+    // Check ID
+    if(!spscbuf_isValidID(id))
+    {
+        // Nothing is popped - wrong buffer ID
+        return SPSCBUF_WRONG_ID;
+    }
+    // Apply a pending clean request
+    lui_tail = spscbuf_applyClean(id);
+    // Producer index: acquire (slot data is visible)
+    lui_head = atomic_load_explicit(&buffers[id].head, memory_order_acquire);
+    // Check if buffer is empty
+    if(lui_head == lui_tail)
+    {
+        return SPSCBUF_EMPTY;
+    }
+    // Copy from the slot and release it
+    memcpy(data, spscbuf_Slot(id, lui_tail), buffers[id].elementSize);
+    atomic_store_explicit(&buffers[id].tail, lui_tail + 1,
+        memory_order_release);
+    // Return
+    return SPSCBUF_OK;
+}
+
+/* Copy elements from Buffer without removing them - Consumer only
+ */
+int spscbuf_peekN(int id, void *data, unsigned int count)
+{
+    unsigned int lui_head;
+    unsigned int lui_tail;
+    unsigned int lui_index;
+    unsigned char* lucp_data;
+    // Check ID
+    if(!spscbuf_isValidID(id))
+    {
+        // Nothing is copied - wrong buffer ID
+        return SPSCBUF_WRONG_ID;
+    }
+    // Apply a pending clean request
+    lui_tail = spscbuf_applyClean(id);
+    // Producer index: acquire (slot data is visible)
+    lui_head = atomic_load_explicit(&buffers[id].head, memory_order_acquire);
+    // Limit to the filled positions
+    if(count > (lui_head - lui_tail))
+    {
+        count = lui_head - lui_tail;
+    }
+    // Copy from the slots (slots are not released)
+    lucp_data = data;
+    for(lui_index = 0; lui_index < count; lui_index++)
+    {
+        memcpy(&lucp_data[lui_index * buffers[id].elementSize],
+            spscbuf_Slot(id, lui_tail + lui_index), buffers[id].elementSize);
+    }
+    // Return
+    return (int)count;
+}
+
+/* Remove elements from Buffer (after peek) - Consumer only
+ */
+int spscbuf_discard(int id, unsigned int count)
+{
+    unsigned int lui_head;
+    unsigned int lui_tail;
+    // Check ID
+    if(!spscbuf_isValidID(id))
+    {
+        // Nothing is removed - wrong buffer ID
+        return SPSCBUF_WRONG_ID;
+    }
+    // Own index: relaxed / Producer index: acquire
+    lui_tail = atomic_load_explicit(&buffers[id].tail, memory_order_relaxed);
+    lui_head = atomic_load_explicit(&buffers[id].head, memory_order_acquire);
+    // Limit to the filled positions
+    if(count > (lui_head - lui_tail))
+    {
+        count = lui_head - lui_tail;
+    }
+    // Release the slots
+    atomic_store_explicit(&buffers[id].tail, lui_tail + count,
+        memory_order_release);
+    // Return
+    return (int)count;
+}
+
+/**
+ * Remove all elements from the buffer (applied on the next pop / peek)
+ */
+void spscbuf_clean(int id)
+{
+    unsigned int lui_head;
+    if(!spscbuf_isValidID(id))
+    {
+        return;
+    }
+    lui_head = atomic_load_explicit(&buffers[id].head, memory_order_acquire);
+    atomic_store_explicit(&buffers[id].cleanHead, lui_head,
+        memory_order_relaxed);
+    atomic_store_explicit(&buffers[id].cleanRequest, true,
+        memory_order_release);
+}
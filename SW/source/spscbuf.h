@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------//
+//                               OBJECT HISTORY                               //
+//----------------------------------------------------------------------------//
+//  REVISION |    DATE     |                               |      AUTHOR      //
+//----------------------------------------------------------------------------//
+//  1.00     | 16/Oct/2026 |                               | ALCP             //
+// - First Version: lock-free single producer / single consumer buffer        //
+//----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - Push notifications with eventfd (spscbuf_enableEvents)                   //
+//----------------------------------------------------------------------------//
+
+#ifndef SPSCBUF_H
+#define SPSCBUF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------//
+// EXTERNAL DEFINITIONS
+//----------------------------------------------------------------------------//
+#define SPSCBUF_ERROR_TOO_MANY_BUFFERS  -1
+#define SPSCBUF_ERROR_TOO_MANY_ELEMENTS -2
+#define SPSCBUF_ERROR_NO_MEMORY         -3
+#define SPSCBUF_OK          1
+#define SPSCBUF_EMPTY       0
+#define SPSCBUF_FULL        -1
+#define SPSCBUF_WRONG_ID    -2
+
+//----------------------------------------------------------------------------//
+// EXTERNAL FUNCTIONS
+//----------------------------------------------------------------------------//
+/*
+ * REMARK: Only ONE thread may push (producer) and only ONE thread may pop
+ * (consumer) for a given buffer ID. No lock is taken: the producer owns the
+ * head index and the consumer owns the tail index (each on its own cache
+ * line), and the data is published with release / acquire atomics.
+ * If more threads have to push to the same buffer, the caller has to
+ * serialize them (the consumer stays lock-free).
+ */
+
+/**
+ * Buffer Initialization. All the slots are allocated here.
+ *
+ * \param   elements    Number of elements (rounded up to a power of 2)
+ * \param   size        Size (in bytes) of each element
+ * \return  If error: SPSCBUF_ERROR_TOO_MANY_BUFFERS /
+ *                    SPSCBUF_ERROR_TOO_MANY_ELEMENTS /
+ *                    SPSCBUF_ERROR_NO_MEMORY
+ *          If OK: Buffer ID
+ */
+int spscbuf_init(unsigned int elements, unsigned int size);
+
+/**
+ * Enable the push notifications: an eventfd is signalled by every push (one 
+ * signal per spscbuf_pushN), so the consumer can sleep (poll / epoll) until 
+ * there is data. To be called before the producer starts.
+ *
+ * \param   id    Buffer ID
+ * \return  eventfd (non-blocking) / -1 on error
+ */
+int spscbuf_enableEvents(int id);
+
+/**
+ * Returns the positions filled for a given buffer ID (any thread - the value
+ * may be outdated as soon as it is returned).
+ *
+ * \param   id    Buffer ID
+ * \return  number of elements in the buffer
+ */
+unsigned int spscbuf_dataCount(int id);
+
+/**
+ * Buffer Push: Copy one element to the buffer - PRODUCER ONLY.
+ *
+ * \param   id      Buffer ID
+ * \param   data    Element to be copied (element size set on init)
+ * \return  SPSCBUF_OK / SPSCBUF_FULL (nothing pushed) / SPSCBUF_WRONG_ID
+ */
+int spscbuf_push(int id, const void *data);
+
+/**
+ * Buffer Push: Copy up to count elements to the buffer and publish them at 
+ * once - PRODUCER ONLY.
+ *
+ * \param   id      Buffer ID
+ * \param   data    Elements to be copied (count * element size set on init)
+ * \param   count   Number of elements
+ * \return  Number of elements pushed (less than count if the buffer is full) /
+ *          SPSCBUF_WRONG_ID
+ */
+int spscbuf_pushN(int id, const void *data, unsigned int count);
+
+/**
+ * Buffer Pop: Copy one element from the buffer and remove it - CONSUMER ONLY.
+ *
+ * \param   id      Buffer ID
+ * \param   data    Element to be filled (element size set on init)
+ * \return  SPSCBUF_OK / SPSCBUF_EMPTY / SPSCBUF_WRONG_ID
+ */
+int spscbuf_pop(int id, void *data);
+
+/**
+ * Buffer Peek: Copy up to count elements from the buffer WITHOUT removing 
+ * them - CONSUMER ONLY. Use spscbuf_discard to remove the ones handled.
+ *
+ * \param   id      Buffer ID
+ * \param   data    Elements to be filled (count * element size set on init)
+ * \param   count   Maximum number of elements
+ * \return  Number of elements copied (0 if empty) / SPSCBUF_WRONG_ID
+ */
+int spscbuf_peekN(int id, void *data, unsigned int count);
+
+/**
+ * Buffer Discard: Remove up to count elements from the buffer (oldest first) 
+ * - CONSUMER ONLY.
+ *
+ * \param   id      Buffer ID
+ * \param   count   Number of elements
+ * \return  Number of elements removed / SPSCBUF_WRONG_ID
+ */
+int spscbuf_discard(int id, unsigned int count);
+
+/**
+ * Remove all elements from the buffer - Any thread. The request is applied by
+ * the consumer on its next pop / peek (elements pushed before this call are
+ * discarded).
+ *
+ * \param   id    Buffer ID
+ * \return  Nothing
+ */
+void spscbuf_clean(int id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSCBUF_H */
+
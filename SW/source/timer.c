@@ -6,6 +6,15 @@
 //  1.00     | 17/Aug/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - Timers indexed by the (dense) stateMachineID                             //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Hierarchical timing wheel (ms): O(1) set / cancel, callbacks             //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - Scheduler job at the next expiration (no fixed period), timer_createJob  //
+//----------------------------------------------------------------------------//
 
 /*
 * Includes
@@ -17,41 +26,321 @@
 #include <stdbool.h>
 #include <limits.h>
 #include <pthread.h>
+#include <time.h>
 #include <auxiliary.h>
-#include <buffer.h>
 #include <debug.h>
+#include <scheduler.h>
 #include <timer.h>
 
 //----------------------------------------------------------------------------//
 // INTERNAL DEFINITIONS
 //----------------------------------------------------------------------------//
+/* Timing wheel: 1ms ticks, 4 levels of 64 slots (slot span: 1ms, 64ms, 
+ * 4.096s, 262.144s). A level is moved down (cascade) when the lower one wraps
+ */
+#define TIMER_WHEEL_BITS    6
+#define TIMER_WHEEL_SLOTS   (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK    (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS  4
+// Lists: wheel slots (level * TIMER_WHEEL_SLOTS + slot) and expired timers
+#define TIMER_LIST_FIRED    (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS)
+#define TIMER_LISTS         (TIMER_LIST_FIRED + 1)
+#define TIMER_NONE          -1
+// Expired timers handed to the callback at once
+#define TIMER_FIRE_BATCH    64
+// No tick to be checked (no timers running)
+#define TIMER_NO_TICK       UINT64_MAX
+// Longest scheduler deadline - ms (further ticks: woken again on the way)
+#define TIMER_MAX_SLEEP     60000UL
 
 //----------------------------------------------------------------------------//
 // INTERNAL TYPES
 //----------------------------------------------------------------------------//
-// Event (for event processing)
+// Timer of a state machine (timerDataArray index: stateMachineID)
 typedef struct  
 {
-    int16_t stateMachineID;
     harpiTimerStatus_t status;
-    int16_t value;
+    uint64_t expires;       // tick (ms)
+    uint32_t sequence;      // timer_setTimer
+    int16_t list;           // wheel slot / TIMER_LIST_FIRED / TIMER_NONE
+    int16_t prev;           // list (timerDataArray index)
+    int16_t next;
 } timerData_t;
 
+// Expired timer (callback)
+typedef struct
+{
+    int16_t stateMachineID;
+    uint32_t sequence;
+} timerFired_t;
+
 //----------------------------------------------------------------------------//
 // INTERNAL GLOBAL VARIABLES
 //----------------------------------------------------------------------------//
 static pthread_mutex_t g_Timers_mutex = PTHREAD_MUTEX_INITIALIZER;
 static timerData_t* timerDataArray = NULL;
 static int16_t timerDataArrayLen = 0;
+static timerCallback_t g_timerCallback = NULL;
+// Timing wheel: first timer of each list, next tick to be checked
+static int16_t g_timerLists[TIMER_LISTS];
+static uint64_t g_wheelTick = 0;
+static int32_t g_wheelTimers = 0;   // Timers in the wheel (running)
+static uint32_t g_timerSequence = 0;
+// Scheduler job (timer_periodic) and the tick its deadline was set to
+static int g_timerJobID = SCHEDULER_ERROR;
+static uint64_t g_wheelNext = TIMER_NO_TICK;
 
 //----------------------------------------------------------------------------//
 // INTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
+static uint64_t getTicks(void);
+static void listAdd(int16_t list, int16_t id);
+static void listRemove(int16_t id);
+static void wheelAdd(int16_t id);
+static void wheelCascade(int16_t list);
+static uint64_t wheelNext(void);
+static void wheelArm(uint64_t tick);
+static void wheelAdvance(uint64_t now);
+
+// Monotonic time - ms
+static uint64_t getTicks(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+// Add a timer to a list (first)
+static void listAdd(int16_t list, int16_t id)
+{
+    timerDataArray[id].list = list;
+    timerDataArray[id].prev = TIMER_NONE;
+    timerDataArray[id].next = g_timerLists[list];
+    if(g_timerLists[list] != TIMER_NONE)
+    {
+        timerDataArray[g_timerLists[list]].prev = id;
+    }
+    g_timerLists[list] = id;
+}
+
+// Remove a timer from its list (if any)
+static void listRemove(int16_t id)
+{
+    timerData_t* timer;
+    timer = &timerDataArray[id];
+    if(timer->list == TIMER_NONE)
+    {
+        return;
+    }
+    if(timer->prev != TIMER_NONE)
+    {
+        timerDataArray[timer->prev].next = timer->next;
+    }
+    else
+    {
+        g_timerLists[timer->list] = timer->next;
+    }
+    if(timer->next != TIMER_NONE)
+    {
+        timerDataArray[timer->next].prev = timer->prev;
+    }
+    timer->list = TIMER_NONE;
+    timer->prev = TIMER_NONE;
+    timer->next = TIMER_NONE;
+}
+
+// Add a timer to the wheel slot of its expiration tick
+static void wheelAdd(int16_t id)
+{
+    timerData_t* timer;
+    uint64_t delta;
+    int16_t level;
+    timer = &timerDataArray[id];
+    if(timer->expires < g_wheelTick)
+    {
+        // Late: next tick
+        timer->expires = g_wheelTick;
+    }
+    delta = timer->expires - g_wheelTick;
+    for(level = 0; level < TIMER_WHEEL_LEVELS - 1; level++)
+    {
+        if(delta < (1ULL << (TIMER_WHEEL_BITS * (level + 1))))
+        {
+            break;
+        }
+    }
+    listAdd(level * TIMER_WHEEL_SLOTS + 
+        ((timer->expires >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK), 
+        id);
+}
+
+// Move the timers of an upper level slot down (closer to expiration)
+static void wheelCascade(int16_t list)
+{
+    int16_t id;
+    int16_t next;
+    id = g_timerLists[list];
+    g_timerLists[list] = TIMER_NONE;
+    while(id != TIMER_NONE)
+    {
+        next = timerDataArray[id].next;
+        timerDataArray[id].list = TIMER_NONE;
+        wheelAdd(id);
+        id = next;
+    }
+}
+
+/* First tick with something to be done: a level 0 slot with timers or the 
+ * cascade of an upper level slot with timers. TIMER_NO_TICK if no timers.
+ */
+static uint64_t wheelNext(void)
+{
+    uint64_t next;
+    uint64_t tick;
+    int16_t shift;
+    int16_t level;
+    int16_t i;
+    if(g_wheelTimers == 0)
+    {
+        return TIMER_NO_TICK;
+    }
+    next = TIMER_NO_TICK;
+    for(i = 0; i < TIMER_WHEEL_SLOTS; i++)
+    {
+        tick = g_wheelTick + i;
+        if(g_timerLists[tick & TIMER_WHEEL_MASK] != TIMER_NONE)
+        {
+            next = tick;
+            break;
+        }
+    }
+    // Upper levels: a slot can be a whole turn ahead (i up to SLOTS)
+    for(level = 1; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        shift = TIMER_WHEEL_BITS * level;
+        for(i = 0; i <= TIMER_WHEEL_SLOTS; i++)
+        {
+            tick = ((g_wheelTick >> shift) + i) << shift;
+            if(tick < g_wheelTick)
+            {
+                // Slot already cascaded
+                continue;
+            }
+            if(tick >= next)
+            {
+                break;
+            }
+            if(g_timerLists[level * TIMER_WHEEL_SLOTS + 
+                ((tick >> shift) & TIMER_WHEEL_MASK)] != TIMER_NONE)
+            {
+                next = tick;
+                break;
+            }
+        }
+    }
+    return next;
+}
+
+// Set the deadline of timer_periodic to a tick (TIMER_NO_TICK: none)
+static void wheelArm(uint64_t tick)
+{
+    uint64_t now;
+    uint64_t delay;
+    g_wheelNext = tick;
+    if(g_timerJobID == SCHEDULER_ERROR)
+    {
+        return;
+    }
+    if(tick == TIMER_NO_TICK)
+    {
+        scheduler_clearDeadline(g_timerJobID);
+        return;
+    }
+    now = getTicks();
+    delay = (tick > now) ? (tick - now) : 0;
+    if(delay > TIMER_MAX_SLEEP)
+    {
+        delay = TIMER_MAX_SLEEP;
+    }
+    scheduler_setDeadline(g_timerJobID, (unsigned long)(delay * 1000UL));
+}
+
+// Check all the ticks up to now: expired timers moved to the fired list
+static void wheelAdvance(uint64_t now)
+{
+    int16_t level;
+    int16_t list;
+    int16_t id;
+    int16_t next;
+    uint64_t tick;
+    while(1)
+    {
+        // Skip the ticks with nothing to be done
+        tick = wheelNext();
+        if(tick > now)
+        {
+            break;
+        }
+        g_wheelTick = tick;
+        // Lower level wrapped: cascade the next slot of the upper levels
+        for(level = 1; level < TIMER_WHEEL_LEVELS; level++)
+        {
+            if(g_wheelTick & ((1ULL << (TIMER_WHEEL_BITS * level)) - 1))
+            {
+                break;
+            }
+            wheelCascade(level * TIMER_WHEEL_SLOTS + ((g_wheelTick >> 
+                (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK));
+        }
+        // Expired timers of this tick
+        list = (int16_t)(g_wheelTick & TIMER_WHEEL_MASK);
+        id = g_timerLists[list];
+        g_timerLists[list] = TIMER_NONE;
+        while(id != TIMER_NONE)
+        {
+            next = timerDataArray[id].next;
+            timerDataArray[id].list = TIMER_NONE;
+            timerDataArray[id].status = HARPI_TIMER_EXPIRED;
+            listAdd(TIMER_LIST_FIRED, id);
+            g_wheelTimers--;
+            id = next;
+        }
+        g_wheelTick++;
+    }
+    if(g_wheelTick <= now)
+    {
+        g_wheelTick = now + 1;
+    }
+}
 
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
-void timer_createTimers(int16_t ntimers, int16_t* smIDArray)
+int timer_createJob(void)
+{
+    int check;
+    check = EXIT_SUCCESS;
+    // LOCK
+    pthread_mutex_lock(&g_Timers_mutex);
+    if(g_timerJobID == SCHEDULER_ERROR)
+    {
+        g_timerJobID = scheduler_addOnDemand(timer_periodic);
+        if(g_timerJobID == SCHEDULER_ERROR)
+        {
+            check = EXIT_FAILURE;
+        }
+        else
+        {
+            // Timers set before
+            wheelArm(wheelNext());
+        }
+    }
+    // UNLOCK
+    pthread_mutex_unlock(&g_Timers_mutex);
+    return check;
+}
+
+void timer_createTimers(int16_t ntimers, timerCallback_t callback)
 {
     int16_t i;
     // LOCK
@@ -63,79 +352,165 @@ void timer_createTimers(int16_t ntimers, int16_t* smIDArray)
         timerDataArray = NULL;
     }
     timerDataArrayLen = 0;
+    // Init wheel
+    for(i = 0; i < TIMER_LISTS; i++)
+    {
+        g_timerLists[i] = TIMER_NONE;
+    }
+    g_wheelTick = getTicks();
+    g_wheelTimers = 0;
+    wheelArm(TIMER_NO_TICK);
+    g_timerCallback = callback;
     // Memory allocation
     if(ntimers > 0)
     {
-        timerDataArrayLen = ntimers;
-        timerDataArray = (timerData_t*)malloc(timerDataArrayLen * 
-            sizeof(timerData_t));
+        timerDataArray = (timerData_t*)malloc(ntimers * sizeof(timerData_t));
+        if(timerDataArray != NULL)
+        {
+            timerDataArrayLen = ntimers;
+        }
     }
     // Set values
     for(i = 0; i < timerDataArrayLen; i++)
     {
-        timerDataArray[i].stateMachineID = smIDArray[i];
         timerDataArray[i].status = HARPI_TIMER_INIT;
-        timerDataArray[i].value = -1;
+        timerDataArray[i].expires = 0;
+        timerDataArray[i].sequence = 0;
+        timerDataArray[i].list = TIMER_NONE;
+        timerDataArray[i].prev = TIMER_NONE;
+        timerDataArray[i].next = TIMER_NONE;
     }
     // UNLOCK
     pthread_mutex_unlock(&g_Timers_mutex);
 }
 
-void timer_setTimer(int16_t stateMachineID, int16_t value)
+uint32_t timer_setTimer(int16_t stateMachineID, uint32_t timeout)
 {
-    int16_t i;
+    timerData_t* timer;
+    uint32_t sequence;
+    // Init - timer not found
+    sequence = 0;
+    if(timeout > TIMER_MAX_TIMEOUT)
+    {
+        timeout = TIMER_MAX_TIMEOUT;
+    }
     // LOCK
     pthread_mutex_lock(&g_Timers_mutex);
-    // Check all timers to find the one to set
-    for(i = 0; i < timerDataArrayLen; i++)
+    // Timer of the state machine
+    if( (stateMachineID >= 0) && (stateMachineID < timerDataArrayLen) )
     {
-        if(timerDataArray[i].stateMachineID == stateMachineID)
+        timer = &timerDataArray[stateMachineID];
+        // Stop (running or expired and not handed to the callback yet)
+        if(timer->status == HARPI_TIMER_RUNNING)
+        {
+            g_wheelTimers--;
+        }
+        listRemove(stateMachineID);
+        // Start
+        g_timerSequence++;
+        if(g_timerSequence == 0)
         {
-            timerDataArray[i].value = value;
-            timerDataArray[i].status = HARPI_TIMER_RUNNING;
+            g_timerSequence++;
+        }
+        timer->sequence = g_timerSequence;
+        timer->expires = getTicks() + timeout;
+        timer->status = HARPI_TIMER_RUNNING;
+        wheelAdd(stateMachineID);
+        g_wheelTimers++;
+        sequence = timer->sequence;
+        // Earlier than the scheduler deadline
+        if(timer->expires < g_wheelNext)
+        {
+            wheelArm(timer->expires);
         }
     }
     // UNLOCK
     pthread_mutex_unlock(&g_Timers_mutex);
+    return sequence;
 }
 
-void timer_periodic(void)
+void timer_cancelTimer(int16_t stateMachineID)
 {
-    int16_t i;
+    timerData_t* timer;
+    uint64_t next;
     // LOCK
     pthread_mutex_lock(&g_Timers_mutex);
-    // Update all timers
-    for(i = 0; i < timerDataArrayLen; i++)
+    // Timer of the state machine
+    if( (stateMachineID >= 0) && (stateMachineID < timerDataArrayLen) )
     {
-        if(timerDataArray[i].value == 0)
+        timer = &timerDataArray[stateMachineID];
+        if(timer->status == HARPI_TIMER_RUNNING)
         {
-            timerDataArray[i].status = HARPI_TIMER_EXPIRED;
+            g_wheelTimers--;
         }
-        if(timerDataArray[i].value > 0)
+        listRemove(stateMachineID);
+        timer->status = HARPI_TIMER_INIT;
+        // Scheduler deadline of the next timer (none if no timers)
+        next = wheelNext();
+        if(next != g_wheelNext)
         {
-            timerDataArray[i].value--;
-            timerDataArray[i].status = HARPI_TIMER_RUNNING;
+            wheelArm(next);
         }
     }
     // UNLOCK
     pthread_mutex_unlock(&g_Timers_mutex);
 }
 
+void timer_periodic(void)
+{
+    timerFired_t fired[TIMER_FIRE_BATCH];
+    timerCallback_t callback;
+    uint64_t now;
+    int16_t id;
+    int count;
+    int i;
+    now = getTicks();
+    // LOCK
+    pthread_mutex_lock(&g_Timers_mutex);
+    // Check the wheel up to now and wait for the next tick to be checked
+    wheelAdvance(now);
+    wheelArm(wheelNext());
+    // UNLOCK
+    pthread_mutex_unlock(&g_Timers_mutex);
+    //------------------------------------------------
+    // Hand the expired timers to the callback in batches (NOT locked: the 
+    // callback may restart them)
+    //------------------------------------------------
+    do
+    {
+        count = 0;
+        // LOCK
+        pthread_mutex_lock(&g_Timers_mutex);
+        callback = g_timerCallback;
+        while( (count < TIMER_FIRE_BATCH) && 
+            (g_timerLists[TIMER_LIST_FIRED] != TIMER_NONE) )
+        {
+            id = g_timerLists[TIMER_LIST_FIRED];
+            listRemove(id);
+            fired[count].stateMachineID = id;
+            fired[count].sequence = timerDataArray[id].sequence;
+            count++;
+        }
+        // UNLOCK
+        pthread_mutex_unlock(&g_Timers_mutex);
+        for(i = 0; (callback != NULL) && (i < count); i++)
+        {
+            callback(fired[i].stateMachineID, fired[i].sequence);
+        }
+    } while(count == TIMER_FIRE_BATCH);
+}
+
 harpiTimerStatus_t timer_getTimerStatus(int16_t stateMachineID)
 {
-    int16_t i;
     harpiTimerStatus_t ret;
     // Init - timer not found
     ret = HARPI_TIMER_UNAVAILABLE;
     // LOCK
     pthread_mutex_lock(&g_Timers_mutex);
-    // Check all timers to find the one to get status
-    for(i = 0; i < timerDataArrayLen; i++)
+    // Timer of the state machine
+    if( (stateMachineID >= 0) && (stateMachineID < timerDataArrayLen) )
     {
-        if(timerDataArray[i].stateMachineID == stateMachineID)
-        {
-            ret = timerDataArray[i].status;
-        }
+        ret = timerDataArray[stateMachineID].status;
     }
     // UNLOCK
     pthread_mutex_unlock(&g_Timers_mutex);
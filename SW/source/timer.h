@@ -6,6 +6,15 @@
 //  1.00     | 17/Aug/2025 |                               | ALCP             //
 // - First version                                                            //
 //----------------------------------------------------------------------------//
+//  1.01     | 16/Oct/2026 |                               | ALCP             //
+// - timer_createTimers: timers indexed by the (dense) stateMachineID         //
+//----------------------------------------------------------------------------//
+//  1.02     | 16/Oct/2026 |                               | ALCP             //
+// - Timing wheel (ms): expiration callbacks, timer_cancelTimer               //
+//----------------------------------------------------------------------------//
+//  1.03     | 16/Oct/2026 |                               | ALCP             //
+// - timer_createJob: timer_periodic run at the next expiration (ms)          //
+//----------------------------------------------------------------------------//
 
 #ifndef TIMER_H
 #define TIMER_H
@@ -21,39 +30,68 @@ extern "C" {
 //----------------------------------------------------------------------------//
 // EXTERNAL DEFINITIONS
 //----------------------------------------------------------------------------//    
+// Maximum timeout - ms (longer timeouts are truncated: ~4.6h)
+#define TIMER_MAX_TIMEOUT   ((1UL << 24) - 1)
     
 //----------------------------------------------------------------------------//
 // EXTERNAL TYPES
 //----------------------------------------------------------------------------//
+/* Expiration callback: called by timer_periodic with the timers NOT locked 
+ * (timer_setTimer can be called). The timer may have been restarted in the
+ * meantime: compare the sequence with the one returned by timer_setTimer.
+ */
+typedef void (*timerCallback_t)(int16_t stateMachineID, uint32_t sequence);
     
 //----------------------------------------------------------------------------//
 // EXTERNAL FUNCTIONS
 //----------------------------------------------------------------------------//
 /**
- * Create timers
+ * Create the scheduler job of the timers (to be called once): timer_periodic
+ * runs at the next expiration only (ms resolution, nothing scheduled while 
+ * no timers are running)
+ * 
+ * \return  EXIT_SUCCESS
+ *          EXIT_FAILURE
+ **/
+int timer_createJob(void);
+
+/**
+ * Create timers: one per state machine, indexed by the (dense) 
+ * stateMachineID - 0..ntimers-1
  * 
  * \param       ntimers: number of timers to be created
- * \param       smIDArray: an array with the stateMachineID of each timer
+ *              callback: called when a timer expires (NULL: none)
+ * 
+ **/
+void timer_createTimers(int16_t ntimers, timerCallback_t callback);
+
+/**
+ * (Re)start the timer of a stateMachineID - O(1)
+ * \param       stateMachineID: timer index
+ * \param       timeout: ms (up to TIMER_MAX_TIMEOUT)
  * 
+ * \return      sequence of the timer (passed to the callback) / 0 on error
  **/
-void timer_createTimers(int16_t ntimers, int16_t* smIDArray);
+uint32_t timer_setTimer(int16_t stateMachineID, uint32_t timeout);
 
 /**
- * set timer with specific value
- * \param       stateMachineID: number of timers to be created
- * \param       value: value in 100ms base (ex: 3 = 300ms)
+ * Stop the timer of a stateMachineID (no callback) - O(1)
+ * \param       stateMachineID: timer index
  * 
  **/
-void timer_setTimer(int16_t stateMachineID, int16_t value);
+void timer_cancelTimer(int16_t stateMachineID);
 
 /**
- * Periodic update of timers - To be called every 100ms
+ * Update of timers: the expired timers are handed to the callback. Run by 
+ * the scheduler at the next expiration (timer_createJob), the deadline being
+ * set again by timer_setTimer / timer_cancelTimer and by this function
  **/
 void timer_periodic(void);
 
 /**
- * get the timer status of a given stateMachineID
- * \param       stateMachineID: number of timers to be created
+ * get the timer status of a given stateMachineID (diagnostics - the timer
+ * owner is told about the expirations by the callback)
+ * \param       stateMachineID: timer index
  * 
  **/
 harpiTimerStatus_t timer_getTimerStatus(int16_t stateMachineID);